@@ -74,6 +74,8 @@ gadgetHandler = {
 
   CMDIDs = {},
 
+  callInFilters = {}, -- [callInName][gadget] = {unitDefs = set, teams = set, weaponDefs = set}
+
   xViewSize    = 1,
   yViewSize    = 1,
   xViewSizeOld = 1,
@@ -92,6 +94,44 @@ do
 end
 
 
+-- call-ins the engine can pre-filter, see Script.SetCallInFilter
+local FILTERED_CALLINS = {
+  'UnitCreated',
+  'UnitFinished',
+  'UnitDestroyed',
+  'UnitIdle',
+  'UnitCommand',
+  'UnitCmdDone',
+  'UnitDamaged',
+  'UnitDamagedBatch',
+}
+local FILTER_KEYS = { 'unitDefs', 'teams', 'weaponDefs' }
+
+do
+  for _,name in ipairs(FILTERED_CALLINS) do
+    gadgetHandler.callInFilters[name] = {}
+  end
+end
+
+
+local function PassCallInFilter(filter, unitDefID, teamID, weaponDefID)
+  if (filter == nil) then
+    return true
+  end
+  if (filter.unitDefs and not filter.unitDefs[unitDefID]) then
+    return false
+  end
+  if (filter.teams and not filter.teams[teamID]) then
+    return false
+  end
+  -- special (negative) weaponDefIDs always pass, as in the engine
+  if (filter.weaponDefs and weaponDefID and weaponDefID >= 0 and not filter.weaponDefs[weaponDefID]) then
+    return false
+  end
+  return true
+end
+
+
 -- Utility call
 local isSyncedCode = (SendToUnsynced ~= nil)
 local function IsSyncedCode()
@@ -304,6 +344,9 @@ function gadgetHandler:NewGadget()
   gh.RemoveCallIn = function (_, name)
     self:RemoveGadgetCallIn(name, gadget)
   end
+  gh.SetCallInFilter = function (_, name, filter)
+    return self:SetGadgetCallInFilter(name, gadget, filter)
+  end
 
   gh.RegisterCMDID = function(_, id)
     self:RegisterCMDID(gadget, id)
@@ -500,6 +543,9 @@ function gadgetHandler:RemoveGadget(gadget)
   end
 
   ArrayRemove(self.gadgets, gadget)
+  for _,filters in pairs(self.callInFilters) do
+    filters[gadget] = nil
+  end
   self:RemoveGadgetGlobals(gadget)
   actionHandler.RemoveGadgetActions(gadget)
   for _,listname in ipairs(CALLIN_LIST) do
@@ -537,6 +583,74 @@ function gadgetHandler:UpdateCallIn(name)
   end
 
   Script.UpdateCallIn(name)
+
+  if (self.callInFilters[name]) then
+    self:UpdateCallInFilter(name)
+  end
+end
+
+
+-- restricts the events of call-in <name> that reach gadget <g> to the
+-- unitDefIDs, teams and weaponDefIDs listed in <filter> (nil clears it)
+function gadgetHandler:SetGadgetCallInFilter(name, g, filter)
+  local filters = self.callInFilters[name]
+  if (filters == nil) then
+    Spring.Log(LOG_SECTION, LOG.ERROR, 'SetGadgetCallInFilter: bad name: ' .. name)
+    return false
+  end
+
+  local sets = nil
+  if (filter ~= nil) then
+    sets = {}
+    for _,key in ipairs(FILTER_KEYS) do
+      if (filter[key] ~= nil) then
+        local set = {}
+        for _,id in ipairs(filter[key]) do
+          set[id] = true
+        end
+        sets[key] = set
+      end
+    end
+  end
+
+  filters[g] = sets
+  self:UpdateCallInFilter(name)
+  return true
+end
+
+
+-- the engine may only drop an event if every gadget
+-- implementing the call-in would have ignored it
+function gadgetHandler:UpdateCallInFilter(name)
+  if (Script.SetCallInFilter == nil) then
+    return
+  end
+
+  local filters = self.callInFilters[name]
+  local union = {}
+
+  for _,key in ipairs(FILTER_KEYS) do
+    local ids = {}
+    local seen = {}
+
+    for _,g in ipairs(self[name .. 'List']) do
+      local set = filters[g] and filters[g][key]
+      if (set == nil) then
+        ids = nil
+        break
+      end
+      for id in pairs(set) do
+        if (not seen[id]) then
+          seen[id] = true
+          ids[#ids + 1] = id
+        end
+      end
+    end
+
+    union[key] = ids
+  end
+
+  Script.SetCallInFilter(name, union)
 end
 
 
@@ -1380,15 +1494,21 @@ end
 --
 
 function gadgetHandler:UnitCreated(unitID, unitDefID, unitTeam, builderID)
+  local filters = self.callInFilters.UnitCreated
   for _,g in r_ipairs(self.UnitCreatedList) do
-    g:UnitCreated(unitID, unitDefID, unitTeam, builderID)
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam)) then
+      g:UnitCreated(unitID, unitDefID, unitTeam, builderID)
+    end
   end
 end
 
 
 function gadgetHandler:UnitFinished(unitID, unitDefID, unitTeam)
+  local filters = self.callInFilters.UnitFinished
   for _,g in r_ipairs(self.UnitFinishedList) do
-    g:UnitFinished(unitID, unitDefID, unitTeam)
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam)) then
+      g:UnitFinished(unitID, unitDefID, unitTeam)
+    end
   end
 end
 
@@ -1423,12 +1543,15 @@ function gadgetHandler:UnitDestroyed(
   attackerID, attackerDefID, attackerTeam,
   weaponDefID
 )
+  local filters = self.callInFilters.UnitDestroyed
   for _,g in r_ipairs(self.UnitDestroyedList) do
-    g:UnitDestroyed(
-      unitID,     unitDefID,     unitTeam,
-      attackerID, attackerDefID, attackerTeam,
-      weaponDefID
-    )
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam, weaponDefID)) then
+      g:UnitDestroyed(
+        unitID,     unitDefID,     unitTeam,
+        attackerID, attackerDefID, attackerTeam,
+        weaponDefID
+      )
+    end
   end
 end
 
@@ -1449,15 +1572,21 @@ end
 
 
 function gadgetHandler:UnitIdle(unitID, unitDefID, unitTeam)
+  local filters = self.callInFilters.UnitIdle
   for _,g in r_ipairs(self.UnitIdleList) do
-    g:UnitIdle(unitID, unitDefID, unitTeam)
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam)) then
+      g:UnitIdle(unitID, unitDefID, unitTeam)
+    end
   end
 end
 
 
 function gadgetHandler:UnitCmdDone(unitID, unitDefID, unitTeam, cmdID, cmdParams, cmdOpts, cmdTag)
+  local filters = self.callInFilters.UnitCmdDone
   for _,g in r_ipairs(self.UnitCmdDoneList) do
-    g:UnitCmdDone(unitID, unitDefID, unitTeam, cmdID, cmdParams, cmdOpts, cmdTag)
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam)) then
+      g:UnitCmdDone(unitID, unitDefID, unitTeam, cmdID, cmdParams, cmdOpts, cmdTag)
+    end
   end
 end
 
@@ -1466,12 +1595,15 @@ function gadgetHandler:UnitCommand(
 	cmdID, cmdParams, cmdOpts, cmdTag,
 	playerID, fromSynced, fromLua
 )
+  local filters = self.callInFilters.UnitCommand
   for _,g in r_ipairs(self.UnitCommandList) do
-    g:UnitCommand(
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam)) then
+      g:UnitCommand(
 		unitID, unitDefID, unitTeam,
 		cmdID, cmdParams, cmdOpts, cmdTag,
 		playerID, fromSynced, fromLua
-	)
+	  )
+    end
   end
 end
 
@@ -1518,10 +1650,52 @@ function gadgetHandler:UnitDamaged(
   attackerDefID,
   attackerTeam
 )
+  local filters = self.callInFilters.UnitDamaged
   for _,g in r_ipairs(self.UnitDamagedList) do
-    g:UnitDamaged(unitID, unitDefID, unitTeam,
-                  damage, paralyzer, weaponDefID, projectileID,
-                  attackerID, attackerDefID, attackerTeam)
+    if (PassCallInFilter(filters[g], unitDefID, unitTeam, weaponDefID)) then
+      g:UnitDamaged(unitID, unitDefID, unitTeam,
+                    damage, paralyzer, weaponDefID, projectileID,
+                    attackerID, attackerDefID, attackerTeam)
+    end
+  end
+end
+
+-- see CSyncedLuaHandle::UnitDamagedBatch for the event layout
+local DAMAGED_BATCH_STRIDE = 10
+
+function gadgetHandler:UnitDamagedBatch(events, numEvents)
+  local filters = self.callInFilters.UnitDamagedBatch
+  for i,g in r_ipairs(self.UnitDamagedBatchList) do
+    local filter = filters[g]
+    if (filter == nil) then
+      -- every gadget but the last one called gets its own copy, so
+      -- none can change the events seen by those called after it
+      local gadgetEvents = events
+      if (i > 1) then
+        gadgetEvents = {}
+        for j = 1, numEvents * DAMAGED_BATCH_STRIDE do
+          gadgetEvents[j] = events[j]
+        end
+      end
+      g:UnitDamagedBatch(gadgetEvents, numEvents)
+    else
+      -- gadgets with a filter get their own copy holding only the matching events
+      local gadgetEvents = {}
+      local gadgetNumEvents = 0
+      for i = 0, numEvents - 1 do
+        local base = i * DAMAGED_BATCH_STRIDE
+        if (PassCallInFilter(filter, events[base + 2], events[base + 3], events[base + 6])) then
+          local dst = gadgetNumEvents * DAMAGED_BATCH_STRIDE
+          for j = 1, DAMAGED_BATCH_STRIDE do
+            gadgetEvents[dst + j] = events[base + j]
+          end
+          gadgetNumEvents = gadgetNumEvents + 1
+        end
+      end
+      if (gadgetNumEvents > 0) then
+        g:UnitDamagedBatch(gadgetEvents, gadgetNumEvents)
+      end
+    end
   end
 end
 
@@ -1838,6 +1838,7 @@ void CGame::SimFrame() {
 
 		teamHandler.GameFrame(gs->frameNum);
 		playerHandler.GameFrame(gs->frameNum);
+		eventHandler.UnitDamagedBatch();
 		eventHandler.GameFramePost(gs->frameNum);
 	}
 
@@ -39,6 +39,7 @@
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/Sound/ISoundChannels.h"
 
 #include "System/Misc/TracyDefs.h"
@@ -54,6 +55,8 @@ void CGameHelper::Init()
 		wdVec.clear();
 		wdVec.reserve(32);
 	}
+
+	weaponTargetCandidates = {};
 }
 
 void CGameHelper::Kill()
@@ -105,37 +108,39 @@ float CGameHelper::CalcImpulseScale(const DamageArray& damages, const float expD
 	return std::clamp(rawImpulseScale, -MAX_EXPLOSION_IMPULSE, MAX_EXPLOSION_IMPULSE);
 }
 
-void CGameHelper::DoExplosionDamage(
-	CUnit* unit,
-	CUnit* owner,
+// per-object result of an explosion, see CalcExplosionHit
+struct ExplosionHit {
+	float3 impulse;
+	float expDist = 0.0f;
+	float expDistanceMod = 0.0f;
+	bool inRange = false;
+};
+
+// unit explosions measure against the last hit piece, feature explosions
+// against the whole volume; the rest of the falloff is shared
+template<typename T>
+static ExplosionHit CalcExplosionHit(
+	const T* object,
 	const float3& expPos,
 	const float expRadius,
-	const float expSpeed,
 	const float expEdgeEffect,
-	const bool ignoreOwner,
-	const DamageArray& damages,
-	const int weaponDefID,
-	const int projectileID
+	const DamageArray& damages
 ) {
-	RECOIL_DETAILED_TRACY_ZONE;
-	assert(unit != nullptr);
-
-	if (ignoreOwner && (unit == owner))
-		return;
+	ExplosionHit hit;
 
-	const LocalModelPiece* lhp = unit->GetLastHitPiece(gs->frameNum);
-	const CollisionVolume* vol = unit->GetCollisionVolume(lhp);
+	const LocalModelPiece* lhp = object->GetLastHitPiece(gs->frameNum);
+	const CollisionVolume* vol = object->GetCollisionVolume(lhp);
 
 	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
-	const float3& volPos = vol->GetWorldSpacePos(unit, lhpPos);
+	const float3& volPos = vol->GetWorldSpacePos(object, lhpPos);
 
 	// linear damage falloff with distance
-	const float expDist = (expRadius != 0.0f) ? vol->GetPointSurfaceDistance(unit, lhp, expPos) : 0.0f;
+	const float expDist = (expRadius != 0.0f) ? vol->GetPointSurfaceDistance(object, std::is_same_v<T, CUnit>? lhp: nullptr, expPos) : 0.0f;
 	const float expRim = expDist * expEdgeEffect;
 
 	// return early if (distance > radius)
 	if (expDist > expRadius)
-		return;
+		return hit;
 
 	// expEdgeEffect should be in [0, 1], so expRadius >= expDist >= expDist*expEdgeEffect
 	assert(expRadius >= expRim);
@@ -149,7 +154,7 @@ void CGameHelper::DoExplosionDamage(
 		? 1.0f
 		: (expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim)
 	;
-	const float modImpulseScale = CalcImpulseScale(damages, expDistanceMod);
+	const float modImpulseScale = CGameHelper::CalcImpulseScale(damages, expDistanceMod);
 
 	// NOTE: if an explosion occurs right underneath a
 	// unit's map footprint, it might cause damage even
@@ -159,56 +164,86 @@ void CGameHelper::DoExplosionDamage(
 	// include units that should not be touched)
 
 	const float3 impulseDir = (volPos - expPos).SafeNormalize();
-	const float3 expImpulse = impulseDir * modImpulseScale;
 
-	DamageArray expDamages = damages * expDistanceMod;
+	hit.impulse = impulseDir * modImpulseScale;
+	hit.expDist = expDist;
+	hit.expDistanceMod = expDistanceMod;
+	hit.inRange = true;
+	return hit;
+}
 
-	if (expDist < (expSpeed * DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE)) {
+void CGameHelper::ApplyExplosionHit(
+	CUnit* unit,
+	CUnit* owner,
+	const ExplosionHit& hit,
+	const float expSpeed,
+	const DamageArray& damages,
+	const int weaponDefID,
+	const int projectileID
+) {
+	if (!hit.inRange)
+		return;
+
+	DamageArray expDamages = damages * hit.expDistanceMod;
+
+	if (hit.expDist < (expSpeed * DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE)) {
 		// damage directly
-		unit->DoDamage(expDamages, expImpulse, owner, weaponDefID, projectileID);
+		unit->DoDamage(expDamages, hit.impulse, owner, weaponDefID, projectileID);
 	} else {
 		// damage later
-		waitingDamages[(gs->frameNum + int(expDist / expSpeed) - (DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE - 1)) & (waitingDamages.size() - 1)].emplace_back(std::move(expDamages), expImpulse, ((owner != nullptr)? owner->id: -1), unit->id, weaponDefID, projectileID);
+		waitingDamages[(gs->frameNum + int(hit.expDist / expSpeed) - (DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE - 1)) & (waitingDamages.size() - 1)].emplace_back(std::move(expDamages), hit.impulse, ((owner != nullptr)? owner->id: -1), unit->id, weaponDefID, projectileID);
 	}
 }
 
-void CGameHelper::DoExplosionDamage(
+void CGameHelper::ApplyExplosionHit(
 	CFeature* feature,
 	CUnit* owner,
+	const ExplosionHit& hit,
+	const DamageArray& damages,
+	const int weaponDefID,
+	const int projectileID
+) {
+	if (!hit.inRange)
+		return;
+
+	feature->DoDamage(damages * hit.expDistanceMod, hit.impulse, owner, weaponDefID, projectileID);
+}
+
+void CGameHelper::DoExplosionDamage(
+	CUnit* unit,
+	CUnit* owner,
 	const float3& expPos,
 	const float expRadius,
+	const float expSpeed,
 	const float expEdgeEffect,
+	const bool ignoreOwner,
 	const DamageArray& damages,
 	const int weaponDefID,
 	const int projectileID
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
-	assert(feature != nullptr);
-
-	const LocalModelPiece* lhp = feature->GetLastHitPiece(gs->frameNum);
-	const CollisionVolume* vol = feature->GetCollisionVolume(lhp);
-
-	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
-	const float3& volPos = vol->GetWorldSpacePos(feature, lhpPos);
-
-	const float expDist = (expRadius != 0.0f) ? vol->GetPointSurfaceDistance(feature, nullptr, expPos) : 0.0f;
-	const float expRim = expDist * expEdgeEffect;
+	assert(unit != nullptr);
 
-	if (expDist > expRadius)
+	if (ignoreOwner && (unit == owner))
 		return;
 
-	assert(expRadius >= expRim);
-
-	const float expDistanceMod = expEdgeEffect == 1.0f || expDist < 1.0f
-		? 1.0f
-		: (expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim)
-	;
-	const float modImpulseScale = CalcImpulseScale(damages, expDistanceMod);
+	ApplyExplosionHit(unit, owner, CalcExplosionHit(unit, expPos, expRadius, expEdgeEffect, damages), expSpeed, damages, weaponDefID, projectileID);
+}
 
-	const float3 impulseDir = (volPos - expPos).SafeNormalize();
-	const float3 expImpulse = impulseDir * modImpulseScale;
+void CGameHelper::DoExplosionDamage(
+	CFeature* feature,
+	CUnit* owner,
+	const float3& expPos,
+	const float expRadius,
+	const float expEdgeEffect,
+	const DamageArray& damages,
+	const int weaponDefID,
+	const int projectileID
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	assert(feature != nullptr);
 
-	feature->DoDamage(damages * expDistanceMod, expImpulse, owner, weaponDefID, projectileID);
+	ApplyExplosionHit(feature, owner, CalcExplosionHit(feature, expPos, expRadius, expEdgeEffect, damages), damages, weaponDefID, projectileID);
 }
 
 
@@ -221,6 +256,8 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	RECOIL_DETAILED_TRACY_ZONE;
 	static std::vector<CUnit*> unitCache;
 	static std::vector<CFeature*> featureCache;
+	static std::vector<ExplosionHit> unitHits;
+	static std::vector<ExplosionHit> featureHits;
 
 	const unsigned int oldNumUnits = unitCache.size();
 	const unsigned int oldNumFeatures = featureCache.size();
@@ -230,22 +267,64 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	const unsigned int newNumUnits = unitCache.size();
 	const unsigned int newNumFeatures = featureCache.size();
 
+	// first evaluate the falloff for every object, which only reads state
+	// and is spread over threads for large blasts; hits are indexed like
+	// the caches so nested explosions (see below) append behind them
+	unitHits.resize(newNumUnits);
+	featureHits.resize(newNumFeatures);
+
+	const auto CalcUnitHit = [&](const int n) {
+		if (params.ignoreOwner && (unitCache[n] == params.owner)) {
+			unitHits[n] = {};
+			return;
+		}
+
+		unitHits[n] = CalcExplosionHit(unitCache[n], params.pos, expRad, params.edgeEffectiveness, params.damages);
+	};
+	const auto CalcFeatureHit = [&](const int n) {
+		featureHits[n] = CalcExplosionHit(featureCache[n], params.pos, expRad, params.edgeEffectiveness, params.damages);
+	};
+
+	if ((newNumUnits - oldNumUnits) >= EXPLOSION_HITS_MT_THRESHOLD) {
+		for_mt(oldNumUnits, newNumUnits, CalcUnitHit);
+	} else {
+		for (unsigned int n = oldNumUnits; n < newNumUnits; n++)
+			CalcUnitHit(n);
+	}
+
+	if ((newNumFeatures - oldNumFeatures) >= EXPLOSION_HITS_MT_THRESHOLD) {
+		for_mt(oldNumFeatures, newNumFeatures, CalcFeatureHit);
+	} else {
+		for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++)
+			CalcFeatureHit(n);
+	}
+
 	// damage all units within the explosion radius
 	// NOTE:
 	//   this can recursively trigger ::Explosion() again
 	//   which would overwrite our object cache if we did
 	//   not keep track of end-markers --> certain objects
 	//   would not be damaged AT ALL (!)
-	for (unsigned int n = oldNumUnits; n < newNumUnits; n++)
-		DoExplosionDamage(unitCache[n], params.owner, params.pos, expRad, params.explosionSpeed, params.edgeEffectiveness, params.ignoreOwner, params.damages, weaponDefID, params.projectileID);
+	// NOTE:
+	//   damage is applied in the same (gathering) order as
+	//   before, only its evaluation happens up front; hits
+	//   are copied since nested explosions may reallocate
+	for (unsigned int n = oldNumUnits; n < newNumUnits; n++) {
+		const ExplosionHit hit = unitHits[n];
+		ApplyExplosionHit(unitCache[n], params.owner, hit, params.explosionSpeed, params.damages, weaponDefID, params.projectileID);
+	}
 
 	unitCache.resize(oldNumUnits);
+	unitHits.resize(oldNumUnits);
 
 	// damage all features within the explosion radius
-	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++)
-		DoExplosionDamage(featureCache[n], params.owner, params.pos, expRad, params.edgeEffectiveness, params.damages, weaponDefID, params.projectileID);
+	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++) {
+		const ExplosionHit hit = featureHits[n];
+		ApplyExplosionHit(featureCache[n], params.owner, hit, params.damages, weaponDefID, params.projectileID);
+	}
 
 	featureCache.resize(oldNumFeatures);
+	featureHits.resize(oldNumFeatures);
 }
 
 void CGameHelper::Explosion(const CExplosionParams& params) {
@@ -655,6 +734,77 @@ namespace {
 
 
 
+float CGameHelper::GetWeaponTargetScanRadius(const CWeapon* weapon)
+{
+	const float aimPosHeight = weapon->aimFromPos.y;
+	const float minMapHeight = std::max(0.0f, readMap->GetCurrMinHeight());
+
+	// find theoretical maximum range based on height above lowest point on map
+	// return weapon->GetRange2D(weapon->autoTargetRangeBoost, (minMapHeight - aimPosHeight) * weapon->weaponDef->heightmod);
+	return (weapon->range + weapon->autoTargetRangeBoost + (aimPosHeight - minMapHeight) * weapon->weaponDef->heightmod);
+}
+
+const std::vector<CUnit*>& CGameHelper::GetWeaponTargetCandidates(const CWeapon* weapon, float scanRadius)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const CUnit* weaponOwner = weapon->owner;
+
+	WeaponTargetCandidates& wtc = weaponTargetCandidates;
+
+	// reusable as long as the owner did not move or change sides and the
+	// previous query was at least as large as the one this weapon needs
+	if (wtc.frameNum == gs->frameNum && wtc.ownerID == weaponOwner->id && wtc.allyTeam == weaponOwner->allyteam) {
+		if (wtc.ownerPos.same(weaponOwner->pos) && wtc.scanRadius >= scanRadius)
+			return wtc.units;
+	}
+
+	wtc.ownerPos = weaponOwner->pos;
+	wtc.scanRadius = scanRadius;
+	wtc.ownerID = weaponOwner->id;
+	wtc.allyTeam = weaponOwner->allyteam;
+	wtc.frameNum = gs->frameNum;
+
+	for (const CWeapon* w: weaponOwner->weapons) {
+		// skip weapons that normally never auto-target, so e.g. a long-ranged
+		// manual-fire weapon does not blow up the query for all the others
+		if (w->weaponDef->noAutoTarget || w->noAutoTarget || w->weaponDef->interceptor || w->slavedTo != nullptr)
+			continue;
+		if (w->weaponDef->manualfire && weaponOwner->unitDef->canManualFire)
+			continue;
+
+		wtc.scanRadius = std::max(wtc.scanRadius, GetWeaponTargetScanRadius(w));
+	}
+
+	QuadFieldQuery qfQuery;
+	quadField.GetQuads(qfQuery, wtc.ownerPos, wtc.scanRadius);
+
+	wtc.units.clear();
+	wtc.units.reserve(32);
+
+	const int tempNum = gs->GetTempNum();
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		if (teamHandler.Ally(wtc.allyTeam, t))
+			continue;
+
+		for (const int qi: *qfQuery.quads) {
+			for (CUnit* targetUnit: quadField.GetQuad(qi).teamUnits[t]) {
+				if (targetUnit->tempNum == tempNum)
+					continue;
+
+				targetUnit->tempNum = tempNum;
+
+				if ((targetUnit->losStatus[wtc.allyTeam] & (LOS_INLOS | LOS_INRADAR)) == 0)
+					continue;
+
+				wtc.units.push_back(targetUnit);
+			}
+		}
+	}
+
+	return wtc.units;
+}
+
 size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<std::pair<float, CUnit*>>& targets)
 {
 	const CUnit*  weaponOwner = weapon->owner;
@@ -667,7 +817,6 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 	const float3 testPos;
 
 	const float aimPosHeight = weapon->aimFromPos.y;
-	const float minMapHeight = std::max(0.0f, readMap->GetCurrMinHeight());
 
 	// how much damage the weapon deals over 1 second
 	const float secDamage = weaponDmg->GetDefault() * weapon->salvoSize / weapon->reloadTime * GAME_SPEED;
@@ -678,108 +827,86 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 
 	const float  baseRange = weapon->range;
 	const float rangeBoost = weapon->autoTargetRangeBoost;
-	// find theoretical maximum range based on height above lowest point on map
-	// const float scanRadius = weapon->GetRange2D(rangeBoost, (minMapHeight - aimPosHeight) * heightMod);
-	const float scanRadius = baseRange + rangeBoost + (aimPosHeight - minMapHeight) * heightMod;
+	const float scanRadius = GetWeaponTargetScanRadius(weapon);
 
 	// [0] := default, [1,2,3,4,5,6] := target is {avoidee, in bad category, crashing, last attacker, paralyzed, outside unboosted range}
 	constexpr float tgtPriorityMults[] = {1.0f, 10.0f, 100.0f, 1000.0f, 0.5f, 4.0f, 100000.0f};
 
 	const bool paralyzer = (weaponDmg->paralyzeDamageTime != 0);
 
-	// copy on purpose since the below calls lua
-	QuadFieldQuery qfQuery;
-	quadField.GetQuads(qfQuery, ownerPos, scanRadius);
+	// the candidates can be a superset of what this weapon's own scan radius
+	// covers (if another weapon of the owner reaches further), the range test
+	// below rejects the extra units
+	const std::vector<CUnit*>& candidateUnits = GetWeaponTargetCandidates(weapon, scanRadius);
 
 	targets.clear();
 	targets.reserve(32);
 
-	const int tempNum = gs->GetTempNum();
-
-	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
-		if (teamHandler.Ally(weaponOwner->allyteam, t))
+	for (CUnit* targetUnit: candidateUnits) {
+		if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
 			continue;
 
-		for (const int qi: *qfQuery.quads) {
-			const std::vector<CUnit*>& allyTeamUnits = quadField.GetQuad(qi).teamUnits[t];
-
-			for (CUnit* targetUnit: allyTeamUnits) {
-				if (targetUnit->tempNum == tempNum)
-					continue;
-
-				targetUnit->tempNum = tempNum;
-
-				if (!weapon->TestTarget(testPos, SWeaponTarget(targetUnit)))
-					continue;
+		const unsigned short targetLOSState = targetUnit->losStatus[weaponOwner->allyteam];
 
-				const unsigned short targetLOSState = targetUnit->losStatus[weaponOwner->allyteam];
+		float targetPriority = tgtPriorityMults[(targetUnit == avoidUnit) * 1];
+		float3 targetPos;
 
-				float targetPriority = tgtPriorityMults[(targetUnit == avoidUnit) * 1];
-				float3 targetPos;
-
-				if (targetLOSState & LOS_INLOS) {
-					targetPos = targetUnit->aimPos;
-				} else if (targetLOSState & LOS_INRADAR) {
-					targetPos = weapon->GetUnitPositionWithError(targetUnit);
-					targetPriority *= tgtPriorityMults[1];
-				} else {
-					continue;
-				}
-
-				const float modRange = weapon->GetRange2D(rangeBoost, (targetPos.y - aimPosHeight) * heightMod);
-				const float sqDist2D = ownerPos.SqDistance2D(targetPos);
-
-				if (sqDist2D > Square(modRange))
-					continue;
+		if (targetLOSState & LOS_INLOS) {
+			targetPos = targetUnit->aimPos;
+		} else if (targetLOSState & LOS_INRADAR) {
+			targetPos = weapon->GetUnitPositionWithError(targetUnit);
+			targetPriority *= tgtPriorityMults[1];
+		} else {
+			continue;
+		}
 
-				const float3 worldTargetDir = (targetPos - ownerPos).SafeNormalize();
-				const float angleOffset =  (1.f - worldMainDir.dot(worldTargetDir));
-				const float angleMod = angleOffset * weaponAimAdjustPriority + 1.f;
+		const float modRange = weapon->GetRange2D(rangeBoost, (targetPos.y - aimPosHeight) * heightMod);
+		const float sqDist2D = ownerPos.SqDistance2D(targetPos);
 
-				// Strengthen focus towards the front, desire should weaken quadratically rather
-				// than linearly otherwise target distance can too easily cause units to choose a
-				// target that requires turning around to fire at.
-				const float angleMul = angleMod*angleMod;
+		if (sqDist2D > Square(modRange))
+			continue;
 
-				const float dist2D = math::sqrt(sqDist2D);
-				const float rangeMul = (dist2D * weaponDef->proximityPriority + modRange * 0.4f + 100.0f);
-				const float damageMul = std::max(0.0001f, weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple);
+		const float3 worldTargetDir = (targetPos - ownerPos).SafeNormalize();
+		const float angleOffset =  (1.f - worldMainDir.dot(worldTargetDir));
+		const float angleMod = angleOffset * weaponAimAdjustPriority + 1.f;
 
-				targetPriority *= angleMul;
-				targetPriority *= rangeMul;
-				targetPriority *= tgtPriorityMults[(dist2D > baseRange) * 6];
+		// Strengthen focus towards the front, desire should weaken quadratically rather
+		// than linearly otherwise target distance can too easily cause units to choose a
+		// target that requires turning around to fire at.
+		const float angleMul = angleMod*angleMod;
 
-				if (targetLOSState & LOS_INLOS) {
-					targetPriority *= (secDamage + targetUnit->health);
+		const float dist2D = math::sqrt(sqDist2D);
+		const float rangeMul = (dist2D * weaponDef->proximityPriority + modRange * 0.4f + 100.0f);
+		const float damageMul = std::max(0.0001f, weaponDmg->Get(targetUnit->armorType) * targetUnit->curArmorMultiple);
 
-					if (paralyzer && targetUnit->paralyzeDamage > (modInfo.paralyzeOnMaxHealth? targetUnit->maxHealth: targetUnit->health))
-						targetPriority *= tgtPriorityMults[5];
+		targetPriority *= angleMul;
+		targetPriority *= rangeMul;
+		targetPriority *= tgtPriorityMults[(dist2D > baseRange) * 6];
 
-					if (weapon->hasTargetWeight)
-						targetPriority *= weapon->TargetWeight(targetUnit);
+		if (targetLOSState & LOS_INLOS) {
+			targetPriority *= (secDamage + targetUnit->health);
 
-				} else {
-					targetPriority *= (secDamage + 10000.0f);
-				}
+			if (paralyzer && targetUnit->paralyzeDamage > (modInfo.paralyzeOnMaxHealth? targetUnit->maxHealth: targetUnit->health))
+				targetPriority *= tgtPriorityMults[5];
 
-				if (targetLOSState & LOS_PREVLOS) {
-					targetPriority /= (damageMul * targetUnit->power);
-					targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
-					targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
-					targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
-				}
+			if (weapon->hasTargetWeight)
+				targetPriority *= weapon->TargetWeight(targetUnit);
 
-				const bool allowTarget = eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority);
+		} else {
+			targetPriority *= (secDamage + 10000.0f);
+		}
 
-				// Lua call may have changed tempNum, so needs to be set again
-				targetUnit->tempNum = tempNum;
+		if (targetLOSState & LOS_PREVLOS) {
+			targetPriority /= (damageMul * targetUnit->power);
+			targetPriority *= tgtPriorityMults[((targetUnit->category & weapon->badTargetCategory) != 0) * 2];
+			targetPriority *= tgtPriorityMults[(targetUnit->IsCrashing()) * 3];
+			targetPriority *= tgtPriorityMults[(targetUnit == lastAttacker) * 4];
+		}
 
-				if (!allowTarget)
-					continue;
+		if (!eventHandler.AllowWeaponTarget(weaponOwner->id, targetUnit->id, weapon->weaponNum, weaponDef->id, &targetPriority))
+			continue;
 
-				targets.emplace_back(targetPriority, targetUnit);
-			}
-		}
+		targets.emplace_back(targetPriority, targetUnit);
 	}
 
 	std::stable_sort(targets.begin(), targets.end(), [](const std::pair<float, CUnit*>& a, const std::pair<float, CUnit*>& b) { return (a.first < b.first); });
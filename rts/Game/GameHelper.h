@@ -21,6 +21,7 @@ class CWeapon;
 class CSolidObject;
 class CFeature;
 class CMobileCAI;
+struct ExplosionHit;
 struct UnitDef;
 struct MoveDef;
 struct BuildInfo;
@@ -148,7 +149,7 @@ public:
 		bool synced = false
 	);
 
-	static size_t GenerateWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<std::pair<float, CUnit*>>& targets);
+	size_t GenerateWeaponTargets(const CWeapon* weapon, const CUnit* avoidUnit, std::vector<std::pair<float, CUnit*>>& targets);
 
 	void Init();
 	void Kill();
@@ -183,6 +184,31 @@ public:
 	void Explosion(const CExplosionParams& params);
 
 private:
+	static float GetWeaponTargetScanRadius(const CWeapon* weapon);
+
+	const std::vector<CUnit*>& GetWeaponTargetCandidates(const CWeapon* weapon, float scanRadius);
+
+	// blasts touching at least this many objects evaluate their falloff in parallel
+	static constexpr unsigned int EXPLOSION_HITS_MT_THRESHOLD = 64;
+
+	void ApplyExplosionHit(
+		CUnit* unit,
+		CUnit* owner,
+		const ExplosionHit& hit,
+		const float expSpeed,
+		const DamageArray& damages,
+		const int weaponDefID,
+		const int projectileID
+	);
+	void ApplyExplosionHit(
+		CFeature* feature,
+		CUnit* owner,
+		const ExplosionHit& hit,
+		const DamageArray& damages,
+		const int weaponDefID,
+		const int projectileID
+	);
+
 	struct WaitingDamage {
 		WaitingDamage(const DamageArray& _damage, const float3& _impulse, int _attackerID, int _targetID, int _weaponID, int _projectileID)
 		: attackerID(_attackerID)
@@ -202,6 +228,25 @@ private:
 		float3 impulse;
 	};
 	
+	/**
+	 * Enemy units (deduplicated, in LOS or radar) around the owner of the
+	 * weapons that last ran GenerateWeaponTargets; the weapons of a unit
+	 * auto-target back to back, so all of them share one QuadField query
+	 * sized for the longest-ranged one.
+	 */
+	struct WeaponTargetCandidates {
+		std::vector<CUnit*> units;
+
+		float3 ownerPos;
+		float scanRadius = 0.0f;
+
+		int ownerID = -1;
+		int allyTeam = -1;
+		int frameNum = -1;
+	};
+
+	WeaponTargetCandidates weaponTargetCandidates;
+
 	std::array<std::vector<WaitingDamage>, 128> waitingDamages;
 	static_assert (std::has_single_bit(std::tuple_size_v <decltype(waitingDamages)>), "Size is used in bit hax and must be 2^N");
 
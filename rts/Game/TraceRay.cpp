@@ -20,8 +20,10 @@
 #include "Sim/Weapons/WeaponDef.h"
 #include "System/GlobalConfig.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "System/Misc/TracyDefs.h"
@@ -30,6 +32,105 @@
 // Local/Helper functions
 //////////////////////////////////////////////////////////////////////
 
+/**
+ * @return true if the segment [pos, pos + dir * length] can come within
+ * <radius> of anything inside <cell> (TestConeHelper only reports hits
+ * within coneSize of points on that segment)
+ */
+static bool ConeCanReachCell(const CQuadField::ObjectBounds& cell, const float3& pos, const float3& dir, float length, float radius)
+{
+	if (cell.noCull)
+		return true;
+
+	float tmin = 0.0f;
+	float tmax = length;
+
+	for (int i = 0; i < 3; i++) {
+		const float mins = cell.mins[i] - radius;
+		const float maxs = cell.maxs[i] + radius;
+
+		if (dir[i] == 0.0f) {
+			if (pos[i] < mins || pos[i] > maxs)
+				return false;
+
+			continue;
+		}
+
+		float t0 = (mins - pos[i]) / dir[i];
+		float t1 = (maxs - pos[i]) / dir[i];
+
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tmin = std::max(tmin, t0);
+		tmax = std::min(tmax, t1);
+
+		if (tmin > tmax)
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @return true if any chord tested by TestTrajectoryConeHelper can pass
+ * through <cell>; all chords lie in the vertical plane through <pos> and
+ * <dir> (2D), within [0, length] along <dir>, and for a downward-curving
+ * trajectory between the muzzle-to-target secant and the curve itself
+ */
+static bool TrajectoryCanReachCell(const CQuadField::ObjectBounds& cell, const float3& pos, const float3& dir, float length, float linear, float quadratic)
+{
+	if (cell.noCull || quadratic > 0.0f)
+		return true;
+
+	const float3 side = {-dir.z, 0.0f, dir.x};
+
+	float xmin =  std::numeric_limits<float>::max();
+	float xmax = -std::numeric_limits<float>::max();
+	float smin =  std::numeric_limits<float>::max();
+	float smax = -std::numeric_limits<float>::max();
+
+	for (int i = 0; i < 4; i++) {
+		const float3 corner = {(i & 1)? cell.maxs.x: cell.mins.x, 0.0f, (i & 2)? cell.maxs.z: cell.mins.z};
+		const float3 relPos = corner - float3(pos.x, 0.0f, pos.z);
+
+		xmin = std::min(xmin, relPos.dot(dir * XZVector));
+		xmax = std::max(xmax, relPos.dot(dir * XZVector));
+		smin = std::min(smin, relPos.dot(side));
+		smax = std::max(smax, relPos.dot(side));
+	}
+
+	if (smin > 0.0f || smax < 0.0f)
+		return false;
+
+	xmin = std::max(xmin, 0.0f);
+	xmax = std::min(xmax, length);
+
+	if (xmin > xmax)
+		return false;
+
+	// lowest point of the secant y = x * (quadratic * length + linear)
+	const float secantSlope = quadratic * length + linear;
+	const float minHeight = pos.y + std::min(xmin * secantSlope, xmax * secantSlope);
+
+	if (cell.maxs.y < minHeight)
+		return false;
+
+	// highest point of the curve y = quadratic * x * x + linear * x
+	const auto CurveHeight = [&](float x) { return (quadratic * x * x + linear * x); };
+
+	float maxHeight = std::max(CurveHeight(xmin), CurveHeight(xmax));
+
+	if (quadratic < 0.0f) {
+		const float xtop = -linear / (2.0f * quadratic);
+
+		if (xtop > xmin && xtop < xmax)
+			maxHeight = std::max(maxHeight, CurveHeight(xtop));
+	}
+
+	return (cell.mins.y <= (pos.y + maxHeight));
+}
+
 /**
  * helper for TestCone
  * @return true if object <o> is in the firing cone, false otherwise
@@ -232,7 +333,9 @@ float TraceRay(
 	if (scanForFeatures || scanForAnyUnits) {
 		CollisionQuery cq;
 
+		// can run on worker threads, see CHitScanBatch
 		QuadFieldQuery qfQuery;
+		qfQuery.threadOwner = ThreadPool::GetThreadNum();
 		quadField.GetQuadsOnRay(qfQuery, pos, dir, traceLength);
 
 		// locally point somewhere non-NULL; we cannot pass hitColQuery
@@ -544,10 +647,17 @@ bool TestCone(
 	const bool scanForNeutrals = ((traceFlags & Collision::NONEUTRALS  ) == 0);
 	const bool scanForFeatures = ((traceFlags & Collision::NOFEATURES  ) == 0);
 
+	// widest the cone gets (at its far end), see TestConeHelper
+	const float maxConeSize = std::max(length * spread, 0.0f) + 1.0f;
+
 	for (const int quadIdx: *qfQuery.quads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
-		if (scanForAllies) {
+		const auto CanReach = [&](const auto& objects, const CQuadField::ObjectBounds& bounds) {
+			return (!objects.empty() && ConeCanReachCell(bounds, from, dir, length, maxConeSize));
+		};
+
+		if (scanForAllies && CanReach(quad.teamUnits[allyteam], quad.teamUnitBounds[allyteam])) {
 			for (const CUnit* u: quad.teamUnits[allyteam]) {
 				if (u == owner)
 					continue;
@@ -559,7 +669,7 @@ bool TestCone(
 			}
 		}
 
-		if (scanForNeutrals) {
+		if (scanForNeutrals && CanReach(quad.units, quad.unitBounds)) {
 			for (const CUnit* u: quad.units) {
 				if (!u->IsNeutral())
 					continue;
@@ -573,7 +683,7 @@ bool TestCone(
 			}
 		}
 
-		if (scanForFeatures) {
+		if (scanForFeatures && CanReach(quad.features, quad.featureBounds)) {
 			for (const CFeature* f: quad.features) {
 				if (!f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
 					continue;
@@ -614,8 +724,12 @@ bool TestTrajectoryCone(
 	for (const int quadIdx: *qfQuery.quads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
+		const auto CanReach = [&](const auto& objects, const CQuadField::ObjectBounds& bounds) {
+			return (!objects.empty() && TrajectoryCanReachCell(bounds, from, dir, length, linear, quadratic));
+		};
+
 		// friendly units in this quad
-		if (scanForAllies) {
+		if (scanForAllies && CanReach(quad.teamUnits[allyteam], quad.teamUnitBounds[allyteam])) {
 			for (const CUnit* u: quad.teamUnits[allyteam]) {
 				if (u == owner)
 					continue;
@@ -629,7 +743,7 @@ bool TestTrajectoryCone(
 		}
 
 		// neutral units in this quad
-		if (scanForNeutrals) {
+		if (scanForNeutrals && CanReach(quad.units, quad.unitBounds)) {
 			for (const CUnit* u: quad.units) {
 				if (!u->IsNeutral())
 					continue;
@@ -644,7 +758,7 @@ bool TestTrajectoryCone(
 		}
 
 		// features in this quad
-		if (scanForFeatures) {
+		if (scanForFeatures && CanReach(quad.features, quad.featureBounds)) {
 			for (const CFeature* f: quad.features) {
 				if (!f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
 					continue;
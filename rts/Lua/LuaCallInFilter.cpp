@@ -0,0 +1,61 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LuaCallInFilter.h"
+#include "LuaInclude.h"
+
+
+static std::vector<bool> ParseMask(lua_State* L, int index, const char* key, size_t maskSize)
+{
+	std::vector<bool> mask;
+
+	lua_getfield(L, index, key);
+
+	// an empty array is the same as no array, not a mask that blocks everything
+	if (lua_istable(L, -1) && lua_objlen(L, -1) > 0) {
+		mask.resize(maskSize, false);
+
+		for (int i = 1, n = lua_objlen(L, -1); i <= n; i++) {
+			lua_rawgeti(L, -1, i);
+
+			if (lua_isnumber(L, -1)) {
+				const size_t id = lua_toint(L, -1);
+
+				// negative IDs wrap around and are ignored
+				if (id < maskSize)
+					mask[id] = true;
+			}
+
+			lua_pop(L, 1);
+		}
+	}
+
+	lua_pop(L, 1);
+	return mask;
+}
+
+
+void LuaCallInFilter::Parse(lua_State* L, int index, size_t numUnitDefs, size_t numTeams, size_t numWeaponDefs)
+{
+	if (!lua_istable(L, index)) {
+		*this = {};
+		return;
+	}
+
+	unitDefs = ParseMask(L, index, "unitDefs", numUnitDefs);
+	teams = ParseMask(L, index, "teams", numTeams);
+	weaponDefs = ParseMask(L, index, "weaponDefs", numWeaponDefs);
+}
+
+bool LuaCallInFilter::Pass(int unitDefID, int teamID, int weaponDefID) const
+{
+	if (!unitDefs.empty() && (static_cast<size_t>(unitDefID) >= unitDefs.size() || !unitDefs[unitDefID]))
+		return false;
+	if (!teams.empty() && (static_cast<size_t>(teamID) >= teams.size() || !teams[teamID]))
+		return false;
+
+	// special (negative) weaponDefIDs are never filtered
+	if (weaponDefs.empty() || weaponDefID < 0 || static_cast<size_t>(weaponDefID) >= weaponDefs.size())
+		return true;
+
+	return weaponDefs[weaponDefID];
+}
@@ -0,0 +1,29 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_CALLIN_FILTER_H
+#define LUA_CALLIN_FILTER_H
+
+#include <cstddef>
+#include <vector>
+
+struct lua_State;
+
+/**
+ * Pre-filter for the events of one unit call-in, set through
+ * Script.SetCallInFilter. Each mask is indexed by ID; an empty mask
+ * (no array given, or an empty one) passes everything.
+ */
+struct LuaCallInFilter {
+public:
+	/// parses the filter table at <index>; anything but a table clears the filter
+	void Parse(lua_State* L, int index, size_t numUnitDefs, size_t numTeams, size_t numWeaponDefs);
+
+	bool Pass(int unitDefID, int teamID, int weaponDefID) const;
+
+public:
+	std::vector<bool> unitDefs;
+	std::vector<bool> teams;
+	std::vector<bool> weaponDefs;
+};
+
+#endif /* LUA_CALLIN_FILTER_H */
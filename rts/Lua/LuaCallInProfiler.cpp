@@ -0,0 +1,158 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LuaCallInProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "LuaHandle.h"
+#include "LuaInclude.h"
+#include "LuaMemPool.h"
+#include "LuaUtils.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "lib/fmt/printf.h"
+
+
+LuaCallInProfiler::Scope::Scope(LuaCallInProfiler& p, const char* callInName, const LuaMemPool* memPool)
+	: profiler(p)
+	, pool(memPool)
+{
+	if (!profiler.enabled)
+		return;
+
+	prevStats = profiler.curCallIn;
+	stats = &profiler.callIns[callInName];
+
+	profiler.curCallIn = stats;
+
+	startTime = spring_now();
+	startBytes = pool->GetAllocedBytes();
+}
+
+LuaCallInProfiler::Scope::~Scope()
+{
+	if (stats == nullptr)
+		return;
+
+	const uint64_t endBytes = pool->GetAllocedBytes();
+
+	stats->numCalls += 1;
+	stats->wallTime += (spring_now() - startTime);
+	// pool counters restart if the handle is cleared mid-call
+	stats->allocedBytes += ((endBytes >= startBytes)? (endBytes - startBytes): endBytes);
+
+	profiler.curCallIn = prevStats;
+}
+
+
+void LuaCallInProfiler::Enable(lua_State* L, int interval)
+{
+	if (!enabled)
+		callIns.clear();
+
+	sampleInterval = std::max(1, interval);
+	enabled = true;
+
+	// hooks are per-thread and <L> may be a coroutine; call-ins run on the
+	// handle's main state, and coroutines created later inherit its hook
+	lua_sethook(CLuaHandle::GetHandle(L)->GetLuaState(), SampleHook, LUA_MASKCOUNT, sampleInterval);
+}
+
+void LuaCallInProfiler::Disable(lua_State* L)
+{
+	// stats are kept so they can still be queried or dumped
+	lua_sethook(CLuaHandle::GetHandle(L)->GetLuaState(), nullptr, 0, 0);
+
+	curCallIn = nullptr;
+	enabled = false;
+}
+
+void LuaCallInProfiler::SampleHook(lua_State* L, lua_Debug* ar)
+{
+	LuaCallInProfiler& profiler = CLuaHandle::GetHandle(L)->GetCallInProfiler();
+	CallInStats* stats = profiler.curCallIn;
+
+	// code run outside of call-ins (e.g. while loading) is not attributed
+	if (stats == nullptr)
+		return;
+	if (lua_getinfo(L, "S", ar) == 0)
+		return;
+
+	stats->numSamples += 1;
+	stats->fileSamples[ar->source] += 1;
+}
+
+
+void LuaCallInProfiler::PushStats(lua_State* L) const
+{
+	lua_createtable(L, 0, callIns.size());
+
+	for (const auto& [callInName, stats]: callIns) {
+		const float wallTime = stats.wallTime.toMilliSecsf();
+
+		lua_pushstring(L, callInName.c_str());
+		lua_createtable(L, 0, 5);
+
+		LuaPushNamedNumber(L, "calls", stats.numCalls);
+		LuaPushNamedNumber(L, "time", wallTime);
+		LuaPushNamedNumber(L, "allocs", stats.allocedBytes);
+		LuaPushNamedNumber(L, "samples", stats.numSamples);
+
+		lua_pushliteral(L, "files");
+		lua_createtable(L, 0, stats.fileSamples.size());
+
+		for (const auto& [fileName, numSamples]: stats.fileSamples) {
+			lua_pushstring(L, fileName.c_str());
+			lua_createtable(L, 0, 2);
+			LuaPushNamedNumber(L, "samples", numSamples);
+			LuaPushNamedNumber(L, "time", wallTime * numSamples / std::max(stats.numSamples, uint64_t(1)));
+			lua_rawset(L, -3);
+		}
+
+		lua_rawset(L, -3);
+		lua_rawset(L, -3);
+	}
+}
+
+bool LuaCallInProfiler::DumpStats(const std::string& handleName, const std::string& fileName) const
+{
+	std::ofstream file(dataDirsAccess.LocateFile(fileName, FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS));
+
+	if (!file.is_open())
+		return false;
+
+	// slowest call-ins and files first
+	std::vector<std::pair<const std::string*, const CallInStats*>> sortedCallIns;
+	std::vector<std::pair<const std::string*, uint64_t>> sortedFiles;
+
+	for (const auto& [callInName, stats]: callIns) {
+		sortedCallIns.emplace_back(&callInName, &stats);
+	}
+
+	std::stable_sort(sortedCallIns.begin(), sortedCallIns.end(), [](const auto& a, const auto& b) { return (a.second->wallTime > b.second->wallTime); });
+
+	file << fmt::sprintf("[LuaCallInProfiler][handle=%s] sampleInterval=%d\n", handleName, sampleInterval);
+
+	for (const auto& [callInName, stats]: sortedCallIns) {
+		const float wallTime = stats->wallTime.toMilliSecsf();
+
+		file << fmt::sprintf("%-32s calls=%u time=%.3fms allocs=%uB samples=%u\n", *callInName, stats->numCalls, wallTime, stats->allocedBytes, stats->numSamples);
+
+		sortedFiles.clear();
+
+		for (const auto& [fileName, numSamples]: stats->fileSamples) {
+			sortedFiles.emplace_back(&fileName, numSamples);
+		}
+
+		std::sort(sortedFiles.begin(), sortedFiles.end(), [](const auto& a, const auto& b) { return (a.second > b.second || (a.second == b.second && *a.first < *b.first)); });
+
+		for (const auto& [fileName, numSamples]: sortedFiles) {
+			file << fmt::sprintf("\t%-64s samples=%u time=%.3fms\n", *fileName, numSamples, wallTime * numSamples / std::max(stats->numSamples, uint64_t(1)));
+		}
+	}
+
+	return true;
+}
+
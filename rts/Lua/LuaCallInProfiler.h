@@ -0,0 +1,80 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_CALLIN_PROFILER_H
+#define LUA_CALLIN_PROFILER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "System/Misc/SpringTime.h"
+#include "System/UnorderedMap.hpp"
+
+struct lua_State;
+struct lua_Debug;
+class LuaMemPool;
+
+/**
+ * Per-handle call-in profiler. Every call-in run through the handle adds
+ * its wall time and the bytes its state allocated, while a count hook
+ * samples which chunk (i.e. Lua file, such as a gadget or widget) is
+ * executing every <sampleInterval> VM instructions; a call-in's time is
+ * attributed to files in proportion to their samples.
+ *
+ * Times include nested call-ins (e.g. UnitDestroyed triggered from within
+ * GameFrame). Garbage is only collected outside of call-ins, so there is no
+ * per-call-in GC time; allocations are what drive it.
+ */
+class LuaCallInProfiler {
+public:
+	struct CallInStats {
+		uint64_t numCalls = 0;
+		uint64_t numSamples = 0;
+		uint64_t allocedBytes = 0;
+
+		spring_time wallTime = spring_notime;
+
+		spring::unordered_map<std::string, uint64_t> fileSamples;
+	};
+
+	class Scope {
+	public:
+		Scope(LuaCallInProfiler& p, const char* callInName, const LuaMemPool* memPool);
+		~Scope();
+
+	private:
+		LuaCallInProfiler& profiler;
+		const LuaMemPool* pool;
+
+		CallInStats* stats = nullptr;
+		CallInStats* prevStats = nullptr;
+
+		spring_time startTime;
+		uint64_t startBytes = 0;
+	};
+
+public:
+	void Enable(lua_State* L, int interval);
+	void Disable(lua_State* L);
+
+	bool IsEnabled() const { return enabled; }
+
+	/// pushes {[callInName] = {calls, time, allocs, samples, files = {[fileName] = {samples, time}}}}
+	void PushStats(lua_State* L) const;
+	bool DumpStats(const std::string& handleName, const std::string& fileName) const;
+
+private:
+	static void SampleHook(lua_State* L, lua_Debug* ar);
+
+private:
+	// std::map keeps CallInStats pointers valid while nested call-ins insert
+	std::map<std::string, CallInStats> callIns;
+
+	CallInStats* curCallIn = nullptr;
+
+	int sampleInterval = 0;
+	bool enabled = false;
+};
+
+#endif
+
@@ -61,15 +61,23 @@ bool LuaFeatureDefs::PushEntries(lua_State* L)
 	const std::array<const IndxFuncType, 3> indxFuncs = {{FeatureDefIndex, FeatureDefNewIndex, FeatureDefMetatable}};
 	const std::array<const IterFuncType, 2> iterFuncs = {{Pairs, Next}};
 
+	// shared by all proxies, keeps the defs table on top for their rawset
+	LuaUtils::PushParamMapKeys(L, paramMap);
+	lua_insert(L, -2);
+
+	const int keysTableIndex = lua_gettop(L) - 1;
+
 	for (const auto& element : defsVec) {
 		const auto def = featureDefHandler->GetFeatureDefByID(element.id); // ObjectDefMapType::mapped_type
 
 		if (def == nullptr)
 			continue;
 
-		PushObjectDefProxyTable(L, indxOpers, iterOpers, indxFuncs, iterFuncs, def);
+		PushObjectDefProxyTable(L, indxOpers, iterOpers, indxFuncs, iterFuncs, def, keysTableIndex);
 	}
 
+	lua_remove(L, keysTableIndex);
+
 	return true;
 }
 
@@ -125,19 +133,18 @@ static int FeatureDefIndex(lua_State* L)
 	}
 
 	const char* name = lua_tostring(L, 2);
-	ParamMap::const_iterator it = paramMap.find(name);
+	const DataElement* elem = LuaUtils::FindParam(L, 2, lua_upvalueindex(2));
 
 	// not a default value
-	if (it == paramMap.end()) {
+	if (elem == nullptr) {
 		lua_rawget(L, 1);
 		return 1;
 	}
 
 	const void* userData = lua_touserdata(L, lua_upvalueindex(1));
 	const FeatureDef* fd = static_cast<const FeatureDef*>(userData);
-	const DataElement& elem = it->second;
-	const void* p = ((const char*)fd) + elem.offset;
-	switch (elem.type) {
+	const void* p = ((const char*)fd) + elem->offset;
+	switch (elem->type) {
 		case READONLY_TYPE: {
 			lua_rawget(L, 1);
 			return 1;
@@ -159,7 +166,7 @@ static int FeatureDefIndex(lua_State* L)
 			return 1;
 		}
 		case FUNCTION_TYPE: {
-			return elem.func(L, p);
+			return elem->func(L, p);
 		}
 		case ERROR_TYPE: {
 			LOG_L(L_ERROR, "[%s] ERROR_TYPE for key \"%s\" in FeatureDefs __index", __func__, name);
@@ -181,10 +188,10 @@ static int FeatureDefNewIndex(lua_State* L)
 	}
 
 	const char* name = lua_tostring(L, 2);
-	ParamMap::const_iterator it = paramMap.find(name);
+	const DataElement* elem = LuaUtils::FindParam(L, 2, lua_upvalueindex(2));
 
 	// not a default value, set it
-	if (it == paramMap.end()) {
+	if (elem == nullptr) {
 		lua_rawset(L, 1);
 		return 0;
 	}
@@ -199,10 +206,9 @@ static int FeatureDefNewIndex(lua_State* L)
 	}
 
 	// Definition editing
-	const DataElement& elem = it->second;
-	const void* p = ((const char*)fd) + elem.offset;
+	const void* p = ((const char*)fd) + elem->offset;
 
-	switch (elem.type) {
+	switch (elem->type) {
 		case FUNCTION_TYPE:
 		case READONLY_TYPE: {
 			luaL_error(L, "Can not write to %s", name);
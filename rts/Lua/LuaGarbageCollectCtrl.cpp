@@ -0,0 +1,56 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LuaGarbageCollectCtrl.h"
+
+#include <algorithm>
+
+#include "Game/GlobalUnsynced.h"
+
+CLuaGarbageCollectSched luaGCSched;
+
+
+void CLuaGarbageCollectSched::Init(bool enabled_, float slackMult_)
+{
+	lastRoundTime = spring_gettime();
+
+	prevRoundAllocs = 0;
+	currRoundAllocs = 0;
+
+	roundRunTime = 0.0f;
+	stateRunTime = 0.0f;
+	slackMult = slackMult_;
+
+	enabled = enabled_;
+}
+
+void CLuaGarbageCollectSched::BeginRound(size_t numStates)
+{
+	const spring_time now = spring_gettime();
+	const float roundPeriod = std::clamp((now - lastRoundTime).toMilliSecsf(), 0.0f, 1000.0f);
+
+	// fractions of wall-clock time spent on sim and draw frames; avgFrameTime
+	// is the period between draw frames (including any sim frames in between)
+	const float simLoad = gu->avgSimFrameTime * gu->simFPS * 0.001f;
+	const float drawLoad = gu->avgDrawFrameTime / std::max(gu->avgFrameTime, 0.001f);
+	const float slack = 1.0f - std::clamp(simLoad + drawLoad, 0.0f, 1.0f);
+
+	lastRoundTime = now;
+
+	prevRoundAllocs = currRoundAllocs;
+	currRoundAllocs = 0;
+
+	roundRunTime = roundPeriod * slack * slackMult;
+	stateRunTime = roundRunTime / std::max(numStates, size_t(1));
+}
+
+float CLuaGarbageCollectSched::GetStateRunTime(uint64_t allocedBytes)
+{
+	currRoundAllocs += allocedBytes;
+
+	// nothing to go by yet (first round or an idle one), split the budget evenly
+	if (prevRoundAllocs == 0)
+		return stateRunTime;
+
+	return (roundRunTime * std::min(1.0f, float(allocedBytes) / float(prevRoundAllocs)));
+}
+
@@ -3,8 +3,12 @@
 #ifndef SPRING_LUA_GARBAGE_COLLECT_CTRL_H
 #define SPRING_LUA_GARBAGE_COLLECT_CTRL_H
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 
+#include "System/Misc/SpringTime.h"
+
 struct SLuaGarbageCollectCtrl {
 	// maximum number of lua_gc calls made in each CollectGarbage loop
 	int itersPerBatch = std::numeric_limits<int>::max();
@@ -20,7 +24,53 @@ struct SLuaGarbageCollectCtrl {
 
 	float baseRunTimeMult = 0.0f;
 	float baseMemLoadMult = 0.0f;
+
+	// pool allocation counter as of the previous (scheduled) collection
+	uint64_t lastAllocedBytes = 0;
+	// profiler timer for this state's collections
+	uint32_t timerNameHash = 0;
 };
 
+
+/**
+ * Spreads extra garbage collection over all Lua states. Each non-forced
+ * round of CEventHandler::CollectGarbage gets a time budget equal to part
+ * of the wall-clock time since the previous round that neither sim nor
+ * draw frames used, and every state receives a share of that budget
+ * matching its share of the bytes allocated by all states during the last
+ * round (or an even share when nothing was allocated). Shares are added on
+ * top of each state's footprint-based runtime.
+ */
+class CLuaGarbageCollectSched {
+public:
+	void Init(bool enabled, float slackMult);
+
+	/// <numStates> is the number of states that will collect this round
+	void BeginRound(size_t numStates);
+
+	/// returns the time (in milliseconds) a state that allocated
+	/// <allocedBytes> since its last collection may spend on GC
+	float GetStateRunTime(uint64_t allocedBytes);
+
+	bool IsEnabled() const { return enabled; }
+	float GetRoundRunTime() const { return roundRunTime; }
+
+private:
+	spring_time lastRoundTime;
+
+	// bytes allocated by all states during the previous and current round
+	uint64_t prevRoundAllocs = 0;
+	uint64_t currRoundAllocs = 0;
+
+	float roundRunTime = 0.0f;
+	// even per-state share of roundRunTime
+	float stateRunTime = 0.0f;
+	float slackMult = 0.5f;
+
+	bool enabled = false;
+};
+
+extern CLuaGarbageCollectSched luaGCSched;
+
 #endif
 
@@ -9,6 +9,7 @@
 #include "LuaCallInCheck.h"
 #include "LuaConfig.h"
 #include "LuaHashString.h"
+#include "LuaIO.h"
 #include "LuaOpenGL.h"
 #include "LuaBitOps.h"
 #include "LuaMathExtra.h"
@@ -33,8 +34,10 @@
 #include "Sim/Features/FeatureDef.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Weapons/Weapon.h"
 #include "Sim/Weapons/WeaponDef.h"
+#include "Sim/Weapons/WeaponDefHandler.h"
 #include "System/creg/SerializeLuaState.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
@@ -42,6 +45,7 @@
 #include "System/GlobalConfig.h"
 #include "System/Rectangle.h"
 #include "System/ScopedFPUSettings.h"
+#include "System/StringHash.h"
 #include "System/StringUtil.h"
 #include "System/Log/ILog.h"
 #include "System/Input/KeyInput.h"
@@ -57,10 +61,13 @@
 #include <tracy/TracyLua.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 
 CONFIG(float, LuaGarbageCollectionMemLoadMult).defaultValue(1.33f).minimumValue(1.0f).maximumValue(100.0f).description("How much the amount of Lua memory in use increases the rate of garbage collection.");
+CONFIG(bool, LuaGarbageCollectionScheduler).defaultValue(true).description("Whether Lua garbage collection may additionally use part of the time left over by sim and draw frames, shared between Lua states by allocation rate.");
+CONFIG(float, LuaGarbageCollectionSlackMult).defaultValue(0.5f).minimumValue(0.0f).maximumValue(1.0f).description("Fraction of the time left over by sim and draw frames that may be spent on Lua garbage collection when LuaGarbageCollectionScheduler is enabled.");
 CONFIG(float, LuaGarbageCollectionRunTimeMult).defaultValue(5.0f).minimumValue(1.0f).description("How many milliseconds the garbage collected can run for in each GC cycle");
 
 
@@ -123,11 +130,10 @@ CLuaHandle::CLuaHandle(const string& _name, int _order, bool _userMode, bool _sy
 	: CEventClient(_name, _order, _synced)
 	, userMode(_userMode)
 	, killMe(false)
-	// no shared pool for LuaIntro to protect against LoadingMT=1
-	// do not use it for LuaMenu either; too many blocks allocated
-	// by *other* states end up not being recycled which presently
-	// forces clearing the shared pool on reload
-	, D(_name != "LuaIntro" && name != "LuaMenu", true)
+	// every handle gets a pool of its own (also protects LuaIntro
+	// against LoadingMT=1), so reloading one releases all its slabs
+	// in bulk without touching the blocks of any other state
+	, D(false, true)
 {
 	D.owner = this;
 	D.synced = _synced;
@@ -135,6 +141,12 @@ CLuaHandle::CLuaHandle(const string& _name, int _order, bool _userMode, bool _sy
 	D.gcCtrl.baseMemLoadMult = configHandler->GetFloat("LuaGarbageCollectionMemLoadMult");
 	D.gcCtrl.baseRunTimeMult = configHandler->GetFloat("LuaGarbageCollectionRunTimeMult");
 
+	// per-state GC time, shown next to the Lua::CollectGarbage::{Synced,Unsynced} totals
+	const std::string gcTimerName = "Lua::CollectGarbage::" + _name + (_synced? "::Synced": "::Unsynced");
+
+	CTimeProfiler::RegisterTimer(gcTimerName.c_str());
+	D.gcCtrl.timerNameHash = hashString(gcTimerName.c_str());
+
 	L = LUA_OPEN(&D);
 	L_GC = lua_newthread(L);
 
@@ -270,10 +282,16 @@ int CLuaHandle::XCall(lua_State* srcState, const char* funcName)
 	RECOIL_DETAILED_TRACY_ZONE;
 	const int top = lua_gettop(L);
 
-	// push the function
+	// push the function; names come from Lua code so they are
+	// looked up without pinning them like LuaHashString::Push
 	const LuaHashString funcHash(funcName);
-	if (!funcHash.GetGlobalFunc(L))
+
+	lua_getglobal(L, funcName);
+
+	if (!lua_isfunction(L, -1)) {
+		lua_pop(L, 1);
 		return 0;
+	}
 
 	int retCount;
 
@@ -365,7 +383,10 @@ int CLuaHandle::RunCallInTraceback(
 			// note1: disable GC outside of this scope to prevent sync errors and similar
 			// note2: we collect garbage now in its own callin "CollectGarbage"
 			// lua_gc(L, LUA_GCRESTART, 0);
-			error = lua_pcall(state, nInArgs, nOutArgs, errFuncIdx);
+			{
+				LuaCallInProfiler::Scope profScope(handle->callInProfiler, luaFunc, GetLuaContextData(state)->memPool);
+				error = lua_pcall(state, nInArgs, nOutArgs, errFuncIdx);
+			}
 			// only run GC inside of "SetHandleRunning(L, true) ... SetHandleRunning(L, false)"!
 			lua_gc(state, LUA_GCSTOP, 0);
 
@@ -1005,6 +1026,9 @@ inline void CLuaHandle::UnitCallIn(const LuaHashString& hs, const CUnit* unit)
 void CLuaHandle::UnitCreated(const CUnit* unit, const CUnit* builder)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_CREATED, unit))
+		return;
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 7, __func__);
 
@@ -1034,6 +1058,9 @@ void CLuaHandle::UnitCreated(const CUnit* unit, const CUnit* builder)
  */
 void CLuaHandle::UnitFinished(const CUnit* unit)
 {
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_FINISHED, unit))
+		return;
+
 	static const LuaHashString cmdStr(__func__);
 	UnitCallIn(cmdStr, unit);
 }
@@ -1134,6 +1161,9 @@ void CLuaHandle::UnitConstructionDecayed(const CUnit* unit, float timeSinceLastB
  */
 void CLuaHandle::UnitDestroyed(const CUnit* unit, const CUnit* attacker, int weaponDefID)
 {
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_DESTROYED, unit, weaponDefID))
+		return;
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 9, __func__);
 
@@ -1226,6 +1256,9 @@ void CLuaHandle::UnitGiven(const CUnit* unit, int oldTeam, int newTeam)
  */
 void CLuaHandle::UnitIdle(const CUnit* unit)
 {
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_IDLE, unit))
+		return;
+
 	static const LuaHashString cmdStr(__func__);
 	UnitCallIn(cmdStr, unit);
 }
@@ -1245,6 +1278,9 @@ void CLuaHandle::UnitIdle(const CUnit* unit)
 void CLuaHandle::UnitCommand(const CUnit* unit, const Command& command, int playerNum, bool fromSynced, bool fromLua)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_COMMAND, unit))
+		return;
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 1 + 7 + 3, __func__);
 
@@ -1279,6 +1315,9 @@ void CLuaHandle::UnitCommand(const CUnit* unit, const Command& command, int play
 void CLuaHandle::UnitCmdDone(const CUnit* unit, const Command& command)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_CMD_DONE, unit))
+		return;
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 8, __func__);
 
@@ -1317,6 +1356,9 @@ void CLuaHandle::UnitDamaged(
 	int projectileID,
 	bool paralyzer)
 {
+	if (!PassCallInFilter(CALLIN_FILTER_UNIT_DAMAGED, unit, weaponDefID))
+		return;
+
 	LUA_CALL_IN_CHECK(L);
 	luaL_checkstack(L, 11, __func__);
 
@@ -3803,7 +3845,13 @@ void CLuaHandle::CollectGarbage(bool forced)
 	const float gcMemLoadMult = D.gcCtrl.baseMemLoadMult;
 	const float gcRunTimeMult = D.gcCtrl.baseRunTimeMult;
 
-	if (!forced && spring_lua_alloc_skip_gc(gcMemLoadMult))
+	// the footprint-based runtime below is a lower bound (subject to random
+	// skipping as before), the scheduler adds this state's share of frame
+	// slack on top so a lack of slack never stops collection altogether
+	const bool gcSkipBase = !forced && spring_lua_alloc_skip_gc(gcMemLoadMult);
+	const float gcSchedRunTime = (!forced && luaGCSched.IsEnabled())? GetScheduledGCRunTime(): 0.0f;
+
+	if (gcSkipBase && gcSchedRunTime <= 0.0f)
 		return;
 
 	LUA_CALL_IN_CHECK_NAMED(L, (GetLuaContextData(L)->synced)? "Lua::CollectGarbage::Synced": "Lua::CollectGarbage::Unsynced");
@@ -3823,7 +3871,7 @@ void CLuaHandle::CollectGarbage(bool forced)
 	// mean too much time is spent on it, must weigh the per-call period
 	const float gcSpeedFactor = std::clamp(gs->speedFactor * (1 - gs->PreSimFrame()) * (1 - gs->paused), 1.0f, 50.0f);
 	const float gcBaseRunTime = smoothstep(10.0f, 100.0f, gcMemFootPrint / 1024);
-	const float gcLoopRunTime = std::clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
+	const float gcLoopRunTime = std::clamp(((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor) * (1 - gcSkipBase) + gcSchedRunTime, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
 
 	const spring_time startTime = spring_gettime();
 	const spring_time   endTime = startTime + spring_msecs(gcLoopRunTime);
@@ -3864,6 +3912,25 @@ void CLuaHandle::CollectGarbage(bool forced)
 	}
 
 	eventHandler.DbgTimingInfo(TIMING_GC, startTime, finishTime);
+	CTimeProfiler::GetInstance().AddTime(D.gcCtrl.timerNameHash, startTime, finishTime - startTime);
+}
+
+float CLuaHandle::GetScheduledGCRunTime()
+{
+	const uint64_t allocedBytes = D.memPool->GetAllocedBytes();
+	// counter restarts whenever the pool's stats are logged
+	const uint64_t allocedBytesDif = allocedBytes - D.gcCtrl.lastAllocedBytes * (allocedBytes >= D.gcCtrl.lastAllocedBytes);
+
+	D.gcCtrl.lastAllocedBytes = allocedBytes;
+
+	SLuaAllocState allocState;
+	spring_lua_alloc_get_stats(&allocState);
+
+	// whatever the slack, make sure collection keeps up as total Lua memory nears the limit
+	const float memLoadRatio = allocState.allocedBytes / float(SLuaAllocLimit::MAX_ALLOC_BYTES);
+	const float memLoadRunTime = smoothstep(0.5f, 1.0f, memLoadRatio) * D.gcCtrl.maxLoopRunTime;
+
+	return (std::max(luaGCSched.GetStateRunTime(allocedBytesDif), memLoadRunTime));
 }
 
 /******************************************************************************/
@@ -3876,6 +3943,10 @@ bool CLuaHandle::AddBasicCalls(lua_State* L)
 	lua_createtable(L, 0, 17); {
 		HSTR_PUSH_CFUNC(L, "Kill",            KillActiveHandle);
 		HSTR_PUSH_CFUNC(L, "UpdateCallIn",    CallOutUpdateCallIn);
+		HSTR_PUSH_CFUNC(L, "SetCallInFilter", CallOutSetCallInFilter);
+		HSTR_PUSH_CFUNC(L, "SetCallInProfiler", CallOutSetCallInProfiler);
+		HSTR_PUSH_CFUNC(L, "GetCallInProfilerStats", CallOutGetCallInProfilerStats);
+		HSTR_PUSH_CFUNC(L, "DumpCallInProfilerStats", CallOutDumpCallInProfilerStats);
 		HSTR_PUSH_CFUNC(L, "GetName",         CallOutGetName);
 		HSTR_PUSH_CFUNC(L, "GetSynced",       CallOutGetSynced);
 		HSTR_PUSH_CFUNC(L, "GetFullCtrl",     CallOutGetFullCtrl);
@@ -4044,6 +4115,127 @@ int CLuaHandle::CallOutUpdateCallIn(lua_State* L)
 	return 0;
 }
 
+
+/***
+ * Restricts which events of a unit call-in reach this Lua state.
+ *
+ * @function Script.SetCallInFilter
+ *
+ * Supported call-ins are UnitCreated, UnitFinished, UnitDestroyed, UnitIdle,
+ * UnitCommand, UnitCmdDone, UnitDamaged and UnitDamagedBatch. The filter table
+ * holds optional `unitDefs`, `teams` and `weaponDefs` arrays of IDs; an event
+ * is delivered only if the unit's unitDefID and team are in the given arrays
+ * and, for UnitDestroyed, UnitDamaged and UnitDamagedBatch, its weaponDefID is
+ * as well (negative weaponDefIDs always pass). Omitted or empty arrays and a nil
+ * filter pass everything.
+ *
+ * @string callInName
+ * @tparam[opt] table filter {unitDefs = {number,...}, teams = {number,...}, weaponDefs = {number,...}}
+ * @treturn bool whether callInName supports filtering
+ */
+int CLuaHandle::CallOutSetCallInFilter(lua_State* L)
+{
+	static constexpr std::array<const char*, CALLIN_FILTER_COUNT> callInNames = {
+		"UnitCreated",
+		"UnitFinished",
+		"UnitDestroyed",
+		"UnitIdle",
+		"UnitCommand",
+		"UnitCmdDone",
+		"UnitDamaged",
+		"UnitDamagedBatch",
+	};
+
+	const char* name = luaL_checkstring(L, 1);
+	const auto iter = std::find_if(callInNames.begin(), callInNames.end(), [&](const char* n) { return (strcmp(n, name) == 0); });
+
+	if (iter == callInNames.end()) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	LuaCallInFilter& filter = GetHandle(L)->callInFilters[iter - callInNames.begin()];
+	filter.Parse(L, 2, unitDefHandler->NumUnitDefs() + 1, teamHandler.ActiveTeams(), weaponDefHandler->NumWeaponDefs());
+
+	lua_pushboolean(L, true);
+	return 1;
+}
+
+/***
+ * Starts or stops profiling the call-ins of this Lua state.
+ *
+ * @function Script.SetCallInProfiler
+ *
+ * While enabled, every call-in records its number of calls, wall time and
+ * allocated bytes, and the chunk (file) being executed is sampled every
+ * `sampleInterval` VM instructions to split each call-in's time across the
+ * gadgets or widgets it ran. Enabling a stopped profiler resets its totals.
+ *
+ * @bool enabled
+ * @number[opt=1000] sampleInterval
+ * @treturn nil
+ */
+int CLuaHandle::CallOutSetCallInProfiler(lua_State* L)
+{
+	LuaCallInProfiler& profiler = GetHandle(L)->callInProfiler;
+
+	if (luaL_checkboolean(L, 1)) {
+		profiler.Enable(L, luaL_optint(L, 2, 1000));
+	} else {
+		profiler.Disable(L);
+	}
+
+	return 0;
+}
+
+/***
+ * @function Script.GetCallInProfilerStats
+ *
+ * Times are in milliseconds, allocations in bytes; per-file times are
+ * estimated from each file's share of the call-in's samples.
+ *
+ * @treturn table {[callInName] = {calls = number, time = number, allocs = number, samples = number, files = {[fileName] = {samples = number, time = number}}}}
+ */
+int CLuaHandle::CallOutGetCallInProfilerStats(lua_State* L)
+{
+	GetHandle(L)->callInProfiler.PushStats(L);
+	return 1;
+}
+
+/***
+ * @function Script.DumpCallInProfilerStats
+ *
+ * Writes the profiler totals to a text file, slowest call-ins first.
+ *
+ * @string[opt="callin_profile_<handleName>.txt"] fileName
+ * @treturn bool success
+ */
+int CLuaHandle::CallOutDumpCallInProfilerStats(lua_State* L)
+{
+	const CLuaHandle* handle = GetHandle(L);
+	const std::string& handleName = handle->GetName();
+	const std::string fileName = luaL_optsstring(L, 1, "callin_profile_" + handleName + ".txt");
+
+	if (!LuaIO::SafeWritePath(fileName) || !LuaIO::IsSimplePath(fileName)) {
+		LOG_L(L_WARNING, "Script.DumpCallInProfilerStats: tried to write to illegal path location");
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	lua_pushboolean(L, handle->callInProfiler.DumpStats(handleName, fileName));
+	return 1;
+}
+
+bool CLuaHandle::PassCallInFilter(int filterIdx, const CUnit* unit, int weaponDefID) const
+{
+	return (PassCallInFilter(filterIdx, unit->unitDef->id, unit->team, weaponDefID));
+}
+
+bool CLuaHandle::PassCallInFilter(int filterIdx, int unitDefID, int teamID, int weaponDefID) const
+{
+	return (callInFilters[filterIdx].Pass(unitDefID, teamID, weaponDefID));
+}
+
 void CLuaHandle::InitializeRmlUi()
 {
 	rmlui = RmlGui::InitializeLua(L);
@@ -6,10 +6,13 @@
 
 #include "System/EventClient.h"
 //FIXME#include "LuaArrays.h"
+#include "LuaCallInFilter.h"
+#include "LuaCallInProfiler.h"
 #include "LuaContextData.h"
 #include "LuaHashString.h"
 #include "lib/lua/include/LuaInclude.h" //FIXME needed for GetLuaContextData
 
+#include <array>
 #include <map>
 #include <string>
 #include <tuple>
@@ -75,6 +78,8 @@ class CLuaHandle : public CEventClient
 
 		static CLuaHandle* GetHandle(lua_State* L) { return (GetLuaContextData(L)->owner); }
 
+		LuaCallInProfiler& GetCallInProfiler() { return callInProfiler; }
+
 		static void SetHandleRunning(lua_State* L, const bool _running) {
 			GetLuaContextData(L)->running += (_running) ? +1 : -1;
 			assert(GetLuaContextData(L)->running >= 0);
@@ -340,12 +345,34 @@ class CLuaHandle : public CEventClient
 		std::map <int, std::vector <std::pair <int, std::vector <int>>>> delayedCallsByFrame;
 		void RunDelayedFunctions(int frameNum);
 
+		float GetScheduledGCRunTime();
+
 		std::vector<bool> watchUnitDefs;        // callin masks for Unit*Collision, UnitMoveFailed
 		std::vector<bool> watchFeatureDefs;     // callin masks for UnitFeatureCollision
 		std::vector<bool> watchProjectileDefs;  // callin masks for Projectile*
 		std::vector<bool> watchExplosionDefs;   // callin masks for Explosion
 		std::vector<bool> watchAllowTargetDefs; // callin masks for AllowWeapon*Target*
 
+		// call-ins whose events can be pre-filtered via Script.SetCallInFilter
+		enum {
+			CALLIN_FILTER_UNIT_CREATED   = 0,
+			CALLIN_FILTER_UNIT_FINISHED  = 1,
+			CALLIN_FILTER_UNIT_DESTROYED = 2,
+			CALLIN_FILTER_UNIT_IDLE      = 3,
+			CALLIN_FILTER_UNIT_COMMAND   = 4,
+			CALLIN_FILTER_UNIT_CMD_DONE  = 5,
+			CALLIN_FILTER_UNIT_DAMAGED   = 6,
+			CALLIN_FILTER_UNIT_DAMAGED_BATCH = 7,
+			CALLIN_FILTER_COUNT          = 8,
+		};
+
+		bool PassCallInFilter(int filterIdx, const CUnit* unit, int weaponDefID = -1) const;
+		bool PassCallInFilter(int filterIdx, int unitDefID, int teamID, int weaponDefID) const;
+
+		std::array<LuaCallInFilter, CALLIN_FILTER_COUNT> callInFilters;
+
+		LuaCallInProfiler callInProfiler;
+
 	private: // call-outs
 		static int KillActiveHandle(lua_State* L);
 		static int CallOutGetName(lua_State* L);
@@ -360,6 +387,10 @@ class CLuaHandle : public CEventClient
 		static int CallOutGetRegistry(lua_State* L);
 		static int CallOutGetCallInList(lua_State* L);
 		static int CallOutUpdateCallIn(lua_State* L);
+		static int CallOutSetCallInFilter(lua_State* L);
+		static int CallOutSetCallInProfiler(lua_State* L);
+		static int CallOutGetCallInProfilerStats(lua_State* L);
+		static int CallOutDumpCallInProfilerStats(lua_State* L);
 		static int CallOutIsEngineMinVersion(lua_State* L);
 		static int CallOutDelayByFrames(lua_State* L);
 
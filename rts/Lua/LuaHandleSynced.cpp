@@ -1521,6 +1521,71 @@ bool CSyncedLuaHandle::UnitPreDamaged(
 }
 
 
+/*** Called at the end of every sim frame with all unit damage events of that frame.
+ *
+ * @function UnitDamagedBatch
+ *
+ * Batched alternative to UnitDamaged (which is still called for every event),
+ * delivered before GameFramePost. Events can be pre-filtered by the victim's
+ * unitDefID and team and by weaponDefID via `Script.SetCallInFilter`, like
+ * UnitDamaged; negative (special) weaponDefIDs are never filtered.
+ *
+ * Every event occupies 10 consecutive entries of `events`: unitID, unitDefID,
+ * unitTeam, damage, paralyzer, weaponDefID, projectileID, attackerID,
+ * attackerDefID, attackerTeam (the attacker fields are -1 if there was none).
+ *
+ * @table events
+ * @number numEvents
+ */
+void CSyncedLuaHandle::UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	LUA_CALL_IN_CHECK(L);
+	luaL_checkstack(L, 2 + 2 + 2, __func__);
+
+	const auto IsWatched = [this](const UnitDamagedEvent& e) {
+		return PassCallInFilter(CALLIN_FILTER_UNIT_DAMAGED_BATCH, e.unitDefID, e.unitTeam, e.weaponDefID);
+	};
+
+	const int numEvents = std::count_if(events.begin(), events.end(), IsWatched);
+
+	if (numEvents == 0)
+		return;
+
+	static constexpr int eventStride = 10;
+
+	const LuaUtils::ScopedDebugTraceBack traceBack(L);
+	static const LuaHashString cmdStr(__func__);
+
+	if (!cmdStr.GetGlobalFunc(L))
+		return;
+
+	lua_createtable(L, numEvents * eventStride, 0);
+
+	int idx = 0;
+
+	for (const UnitDamagedEvent& e: events) {
+		if (!IsWatched(e))
+			continue;
+
+		lua_pushnumber(L, e.unitID       ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.unitDefID    ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.unitTeam     ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.damage       ); lua_rawseti(L, -2, ++idx);
+		lua_pushboolean(L, e.paralyzer   ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.weaponDefID  ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.projectileID ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.attackerID   ); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.attackerDefID); lua_rawseti(L, -2, ++idx);
+		lua_pushnumber(L, e.attackerTeam ); lua_rawseti(L, -2, ++idx);
+	}
+
+	lua_pushnumber(L, numEvents);
+
+	RunCallInTraceback(L, cmdStr, 2, 0, traceBack.GetErrFuncIdx(), false);
+}
+
+
 /*** Called before damage is applied to the feature.
  *
  * @function FeaturePreDamaged
@@ -1793,7 +1858,8 @@ bool CSyncedLuaHandle::AllowWeaponTarget(
  *
  * @function AllowWeaponInterceptTarget
  *
- * Only called for weaponDefIDs registered via Script.SetWatchWeapon.
+ * Only called for weaponDefIDs registered via Script.SetWatchWeapon, and only
+ * for projectiles whose path or target can come within the interceptor's coverage range.
  *
  * @number interceptorUnitID
  * @number interceptorWeaponID
@@ -96,6 +96,8 @@ class CSyncedLuaHandle : public CLuaHandle
 			float* impulseMult
 		) override;
 
+		void UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events) override;
+
 		bool FeaturePreDamaged(
 			const CFeature* feature,
 			const CUnit* attacker,
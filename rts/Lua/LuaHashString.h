@@ -10,6 +10,9 @@
 #include "System/StringHash.h"
 
 
+// engine-side keys are a small fixed set of names, so the strings they push
+// are pinned in the state's string table (see lua_pushfixedhstring) instead
+// of being collected and re-created whenever no table happens to hold them
 struct LuaHashString {
 	public:
 		LuaHashString(const char* s): hash(lua_calchash(s, slen = strlen(s))) {
@@ -33,7 +36,7 @@ struct LuaHashString {
 
 	public:
 		inline void Push(lua_State* L) const {
-			lua_pushhstring(L, hash, str, slen);
+			lua_pushfixedhstring(L, hash, str, slen);
 		}
 
 		inline void GetGlobal(lua_State* L) const {
@@ -104,7 +107,7 @@ struct LuaHashString {
 //       peculiar things will happen. => Only use raw strings (and not variables) in name.
 
 #define HSTR_PUSH(L, name) \
-	{ lua_pushhstring(L, COMPILE_TIME_HASH(name), name, sizeof(name) - 1); }
+	{ lua_pushfixedhstring(L, COMPILE_TIME_HASH(name), name, sizeof(name) - 1); }
 
 #define HSTR_PUSH_BOOL(L, name, val) \
 	{ HSTR_PUSH(L, name); lua_pushboolean(L, val); lua_rawset(L, -3); }
@@ -116,7 +119,7 @@ struct LuaHashString {
 	{ HSTR_PUSH(L, name); lua_pushsstring(L, val); lua_rawset(L, -3); }
 
 #define HSTR_PUSH_CSTRING(L, name, val) \
-	{ HSTR_PUSH(L, name); lua_pushhstring(L, COMPILE_TIME_HASH(val), val, sizeof(val) - 1); lua_rawset(L, -3); }
+	{ HSTR_PUSH(L, name); lua_pushfixedhstring(L, COMPILE_TIME_HASH(val), val, sizeof(val) - 1); lua_rawset(L, -3); }
 
 #define HSTR_PUSH_CFUNC(L, name, val) \
 	{ HSTR_PUSH(L, name); lua_pushcfunction(L, val); lua_rawset(L, -3); }
@@ -103,39 +103,30 @@ LuaMemPool::LuaMemPool(size_t lmpIndex): globalIndex(lmpIndex)
 void LuaMemPool::Clear()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	//allocStats = {};
+	// bulk release; anything the previous user of this pool
+	// did not free (e.g. a state that was never closed) goes
+	// with the slabs rather than lingering until shutdown
+	if (luaMemPoolImpl != nullptr)
+		luaMemPoolImpl->clear();
+
+	allocStats = {};
+	liveBytes = {};
 }
 
 void* LuaMemPool::Alloc(size_t size)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (!LuaMemPool::enabled) {
+	if (!IsInternalSize(size)) {
 		allocStats[STAT_NAE] += 1 * (size > 0);
 		allocStats[STAT_NBE] += size;
-		auto t0 = spring_now();
-		void* ptr = ::operator new(size);
-		allocStats[STAT_NTE] += (spring_now() - t0).toMicroSecsi();
-		return ptr;
+		liveBytes[1] += size;
+		return ::operator new(size);
 	}
 
-	auto t0 = spring_now();
-	auto* ptr = luaMemPoolImpl->allocMem(size);
-	
-	if (size > NUM_BUCKETS * BUCKET_STEP) {
-		allocStats[STAT_NAE] += 1 * (size > 0);
-		allocStats[STAT_NBE] += size;
-		allocStats[STAT_NTE] += (spring_now() - t0).toMicroSecsi();
-	} else if (luaMemPoolImpl->isAllocInternal(ptr)) {
-		allocStats[STAT_NAI] += 1 * (size > 0);
-		allocStats[STAT_NBI] += size;
-		allocStats[STAT_NTI] += (spring_now() - t0).toMicroSecsi();
-	} else {
-		allocStats[STAT_NAF] += 1 * (size > 0);
-		allocStats[STAT_NBF] += size;
-		allocStats[STAT_NTF] += (spring_now() - t0).toMicroSecsi();
-	}
-
-	return ptr;
+	allocStats[STAT_NAI] += 1;
+	allocStats[STAT_NBI] += size;
+	liveBytes[0] += size;
+	return luaMemPoolImpl->allocMem(size);
 }
 
 void* LuaMemPool::Realloc(void* ptr, size_t nsize, size_t osize)
@@ -144,79 +135,65 @@ void* LuaMemPool::Realloc(void* ptr, size_t nsize, size_t osize)
 	if (ptr == nullptr || osize == 0)
 		return Alloc(nsize);
 
-	if (!LuaMemPool::enabled) {
-		void* newPtr = ::operator new(nsize);
-
-		if (newPtr == nullptr)
-			return nullptr;
+	// block is already big enough and not too big for its class
+	if (IsInternalSize(nsize) && IsInternalSize(osize) && LuaMemPoolImpl::SIZE_CLASS(nsize) == LuaMemPoolImpl::SIZE_CLASS(osize)) {
+		liveBytes[0] -= osize;
+		liveBytes[0] += nsize;
+		return ptr;
+	}
 
-		allocStats[STAT_NBE] -= osize;
-		allocStats[STAT_NBE] += nsize;
+	void* newPtr = Alloc(nsize);
 
-		auto t0 = spring_now();
-		std::memcpy(newPtr, ptr, std::min(nsize, osize));
-		std::memset(ptr, 0, osize);
-		::operator delete(ptr);
-		allocStats[STAT_NTE] += (spring_now() - t0).toMicroSecsi();
+	if (newPtr == nullptr)
+		return nullptr;
 
-		return newPtr;
-	}
-
-	auto t0 = spring_now();
-	auto* ret = luaMemPoolImpl->reAllocMem(ptr, nsize);
-	if (nsize > NUM_BUCKETS * BUCKET_STEP) {
-		allocStats[STAT_NAE] += 1 * (nsize > 0);
-		allocStats[STAT_NBE] += nsize;
-		allocStats[STAT_NTE] += (spring_now() - t0).toMicroSecsi();
-	}
-	else if (luaMemPoolImpl->isAllocInternal(ret)) {
-		allocStats[STAT_NAI] += 1 * (nsize > 0);
-		allocStats[STAT_NBI] += nsize;
-		allocStats[STAT_NTI] += (spring_now() - t0).toMicroSecsi();
-	}
-	else {
-		allocStats[STAT_NAF] += 1 * (nsize > 0);
-		allocStats[STAT_NBF] += nsize;
-		allocStats[STAT_NTF] += (spring_now() - t0).toMicroSecsi();
-	}
-	return ret;
+	std::memcpy(newPtr, ptr, std::min(nsize, osize));
+	Free(ptr, osize);
+	return newPtr;
 }
 
 void LuaMemPool::Free(void* ptr, size_t size)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	if (!LuaMemPool::enabled) {
+	if (ptr == nullptr)
+		return;
+
+	if (!IsInternalSize(size)) {
+		liveBytes[1] -= size;
 		::operator delete(ptr);
 		return;
 	}
 
-	luaMemPoolImpl->freeMem(ptr);
+	liveBytes[0] -= size;
+	luaMemPoolImpl->freeMem(ptr, size);
 }
 
 void LuaMemPool::LogStats(const char* handle, const char* lctype)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
 	static constexpr auto one = uint64_t(1);
-	const float intPerc = 100.0f * static_cast<float>(allocStats[STAT_NAI]) / static_cast<float>(std::max(allocStats[STAT_NAI] + allocStats[STAT_NAF] + allocStats[STAT_NAE], one));
-	const float avgAllocTimeI = static_cast<float>(allocStats[STAT_NTI]) / static_cast<float>(std::max(allocStats[STAT_NAI], one));
-	const float avgAllocTimeF = static_cast<float>(allocStats[STAT_NTF]) / static_cast<float>(std::max(allocStats[STAT_NAF], one));
-	const float avgAllocTimeE = static_cast<float>(allocStats[STAT_NTE]) / static_cast<float>(std::max(allocStats[STAT_NAE], one));
+
+	const size_t slabSize = (luaMemPoolImpl != nullptr)? luaMemPoolImpl->slab_size(): 0;
+
+	const float intPerc = 100.0f * static_cast<float>(allocStats[STAT_NAI]) / static_cast<float>(std::max(allocStats[STAT_NAI] + allocStats[STAT_NAE], one));
+	// share of slab memory not holding live data, i.e. free blocks plus size-class rounding
+	const float fragPerc = 100.0f * (1.0f - static_cast<float>(liveBytes[0]) / static_cast<float>(std::max(uint64_t(slabSize), one)));
+
 	std::string msg = fmt::sprintf(
-		"[LuaMemPool::%s][handle=%s (%s)] index=%u numAllocs{int+, int-, ext, int_p}={%u, %u, %u, %.1f} allocedSize{int+, int-, ext}={%u, %u, %u}, avgAllocTime{int+, int-, ext}={%.4f, %.4f, %.4f}",
+		"[LuaMemPool::%s][handle=%s (%s)] index=%u numAllocs{int, ext, int_p}={%u, %u, %.1f} allocedSize{int, ext}={%u, %u} liveSize{int, ext}={%u, %u} slabSize=%u fragmentation=%.1f%%",
 		__func__,
 		handle,
 		lctype,
 		globalIndex,
 		allocStats[STAT_NAI],
-		allocStats[STAT_NAF],
 		allocStats[STAT_NAE],
 		intPerc,
 		allocStats[STAT_NBI],
-		allocStats[STAT_NBF],
 		allocStats[STAT_NBE],
-		avgAllocTimeI,
-		avgAllocTimeF,
-		avgAllocTimeE
+		liveBytes[0],
+		liveBytes[1],
+		slabSize,
+		(slabSize > 0)? fragPerc: 0.0f
 	);
 	LOG("%s", msg.c_str());
 	allocStats = {};
@@ -51,6 +51,9 @@ public:
 
 	void LogStats(const char* handle, const char* lctype);
 
+	// bytes handed out since the last Clear or LogStats
+	uint64_t GetAllocedBytes() const { return (allocStats[STAT_NBI] + allocStats[STAT_NBE]); }
+
 	size_t  GetGlobalIndex() const { return globalIndex; }
 	size_t  GetSharedCount() const { return sharedCount; }
 	size_t& GetSharedCount()       { return sharedCount; }
@@ -58,24 +61,28 @@ public:
 public:
 	static bool enabled;
 private:
-	static constexpr uint32_t NUM_BUCKETS = 32;
-	static constexpr uint32_t BUCKET_STEP = 16;
-	using LuaMemPoolImpl = PassThroughPool<NUM_BUCKETS, 4 * (1024 * 1024)>;
+	// blocks up to NUM_CLASSES * CLASS_STEP bytes (which covers nearly
+	// all strings, tables, closures and upvalues) come from the slabs,
+	// anything larger goes straight to the global heap
+	static constexpr uint32_t NUM_CLASSES = 32;
+	static constexpr uint32_t CLASS_STEP = 16;
+	static constexpr uint32_t SLAB_SIZE = 64 * 1024;
+	using LuaMemPoolImpl = SlabMemPool<NUM_CLASSES, CLASS_STEP, SLAB_SIZE>;
 	std::unique_ptr<LuaMemPoolImpl> luaMemPoolImpl;
 
+	bool IsInternalSize(size_t size) const { return (LuaMemPool::enabled && size > 0 && size <= LuaMemPoolImpl::MAX_SIZE()); }
+
 	enum {
 		STAT_NAI = 0, // number of internal allocs
-		STAT_NAF = 1, // number of int fail allocs
-		STAT_NAE = 2, // number of external allocs
-		STAT_NBI = 3, // number of bytes alloced (internal)
-		STAT_NBF = 4, // number of bytes alloced (int fail)
-		STAT_NBE = 5, // number of bytes alloced (external)
-		STAT_NTI = 6, // cumulative time spent on internal allocs
-		STAT_NTF = 7, // cumulative time spent on int fail allocs
-		STAT_NTE = 8, // cumulative time spent on external allocs
+		STAT_NAE = 1, // number of external allocs
+		STAT_NBI = 2, // number of bytes alloced (internal)
+		STAT_NBE = 3, // number of bytes alloced (external)
 	};
 
-	std::array<uint64_t, 9> allocStats = { 0, 0, 0, 0, 0 };
+	// reset by LogStats
+	std::array<uint64_t, 4> allocStats = {0, 0, 0, 0};
+	// bytes currently held by the state, {internal, external}; only reset by Clear
+	std::array<uint64_t, 2> liveBytes = {0, 0};
 
 	size_t globalIndex = 0;
 	size_t sharedCount = 0;
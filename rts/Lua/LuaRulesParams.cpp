@@ -1,12 +1,159 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "LuaRulesParams.h"
+#include "Sim/Misc/GlobalSynced.h"
+#include "System/StringHash.h"
+#include "System/creg/STL_Pair.h"
 #include "System/creg/STL_Variant.h"
 
+#include <algorithm>
+
 using namespace LuaRulesParams;
 
 CR_BIND(Param,)
 CR_REG_METADATA(Param, (
 	CR_MEMBER(los),
-	CR_MEMBER(value)
+	CR_MEMBER(value),
+	CR_MEMBER(generation)
+))
+
+CR_BIND(Params::RemovedEntry,)
+CR_REG_METADATA_SUB(Params, RemovedEntry, (
+	CR_MEMBER(key),
+	CR_MEMBER(los),
+	CR_MEMBER(generation)
 ))
+
+CR_BIND(Params,)
+CR_REG_METADATA(Params, (
+	CR_MEMBER(entries),
+	CR_IGNORED(keyHashes),
+	CR_IGNORED(keyIndex),
+	CR_MEMBER(removed),
+	CR_MEMBER(prunedGeneration),
+
+	CR_POSTLOAD(PostLoad)
+))
+
+
+uint64_t LuaRulesParams::GetGeneration() { return gs->GetRulesParamsGen(); }
+
+
+int Params::FindIndex(const std::string& key) const
+{
+	if (!keyIndex.empty()) {
+		const auto it = keyIndex.find(key);
+		return ((it == keyIndex.end())? -1: it->second);
+	}
+
+	const uint32_t keyHash = hashString(key);
+
+	for (size_t i = 0, n = keyHashes.size(); i < n; i++) {
+		if (keyHashes[i] == keyHash && entries[i].first == key)
+			return i;
+	}
+
+	return -1;
+}
+
+void Params::RebuildIndex()
+{
+	keyIndex.clear();
+
+	if (entries.size() < INDEX_MIN_SIZE)
+		return;
+
+	keyIndex.reserve(entries.size());
+
+	for (size_t i = 0, n = entries.size(); i < n; i++) {
+		keyIndex.emplace(entries[i].first, i);
+	}
+}
+
+
+void Params::Set(const std::string& key, Param param)
+{
+	const int idx = FindIndex(key);
+
+	if (idx >= 0) {
+		Param& curParam = entries[idx].second;
+
+		// gadgets often re-set unchanged values every frame; keep those clean
+		if (curParam == param)
+			return;
+
+		param.generation = gs->NextRulesParamsGen();
+
+		// readers that could only see the param under its old los have lost it
+		if ((curParam.los & ~param.los) != 0)
+			PushRemoved({key, curParam.los, param.generation});
+
+		curParam = std::move(param);
+		return;
+	}
+
+	param.generation = gs->NextRulesParamsGen();
+
+	entries.emplace_back(key, std::move(param));
+	keyHashes.push_back(hashString(key));
+
+	if (!keyIndex.empty()) {
+		keyIndex.emplace(key, entries.size() - 1);
+	} else if (entries.size() >= INDEX_MIN_SIZE) {
+		RebuildIndex();
+	}
+}
+
+void Params::Erase(const std::string& key)
+{
+	const int idx = FindIndex(key);
+
+	if (idx < 0)
+		return;
+
+	PushRemoved({key, entries[idx].second.los, gs->NextRulesParamsGen()});
+
+	if (!keyIndex.empty())
+		keyIndex.erase(key);
+
+	// order is not significant, move the last entry into the gap
+	if (static_cast<size_t>(idx) != (entries.size() - 1)) {
+		entries[idx] = std::move(entries.back());
+		keyHashes[idx] = keyHashes.back();
+
+		if (!keyIndex.empty())
+			keyIndex[entries[idx].first] = idx;
+	}
+
+	entries.pop_back();
+	keyHashes.pop_back();
+
+	// drop the index only well below INDEX_MIN_SIZE to avoid rebuilding it back and forth
+	if (!keyIndex.empty() && entries.size() < (INDEX_MIN_SIZE / 2))
+		keyIndex.clear();
+}
+
+
+void Params::PushRemoved(RemovedEntry&& entry)
+{
+	removed.push_back(std::move(entry));
+
+	// removals are appended in generation order, so the front is the oldest
+	if (removed.size() > MAX_REMOVED_SIZE) {
+		prunedGeneration = removed.front().generation;
+		removed.erase(removed.begin());
+	}
+}
+
+
+void Params::PostLoad()
+{
+	keyHashes.clear();
+	keyHashes.reserve(entries.size());
+
+	for (const Entry& e: entries) {
+		keyHashes.push_back(hashString(e.first));
+	}
+
+	RebuildIndex();
+}
@@ -3,8 +3,11 @@
 #ifndef LUA_RULESPARAMS_H
 #define LUA_RULESPARAMS_H
 
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "System/UnorderedMap.hpp"
 #include "System/creg/creg_cond.h"
@@ -31,11 +34,95 @@ namespace LuaRulesParams
 	struct Param {
 		CR_DECLARE_STRUCT(Param)
 
+		bool operator == (const Param& p) const { return (los == p.los && value == p.value); }
+		bool operator != (const Param& p) const { return !(*this == p); }
+
 		int   los = RULESPARAMLOS_PRIVATE;
 		std::variant <bool, float, std::string> value;
+
+		// value of GetGeneration() when this param was last changed
+		uint64_t generation = 0;
 	};
 
-	typedef spring::unordered_map<std::string, Param> Params;
+	/**
+	 * Generations are drawn from one synced counter (see CGlobalSynced) that
+	 * is shared by every param set and restarts with each game, so a reader
+	 * can remember the value returned by GetGeneration() and later ask the
+	 * same set for the params that changed since. A set never reports the
+	 * keys of the set it replaced as removed (e.g. the previous unit's params
+	 * behind a reused unitID), so readers must do a full read whenever the
+	 * object behind an ID changes.
+	 */
+	uint64_t GetGeneration();
+
+
+	/**
+	 * Flat storage for a set of params; most sets only hold a handful of keys
+	 * so lookups scan a contiguous array of precomputed key hashes, and only
+	 * large sets (typically the game params) also maintain a hash index.
+	 * Iteration yields (key, Param) pairs like the map this replaces.
+	 */
+	class Params {
+		CR_DECLARE_STRUCT(Params)
+
+	public:
+		typedef std::pair<std::string, Param> Entry;
+		typedef std::vector<Entry>::const_iterator const_iterator;
+
+		// sets at least this large get a hash index
+		static constexpr size_t INDEX_MIN_SIZE = 32;
+		// number of most recent removals remembered per set
+		static constexpr size_t MAX_REMOVED_SIZE = 64;
+
+		struct RemovedEntry {
+			CR_DECLARE_STRUCT(RemovedEntry)
+
+			std::string key;
+			int los;
+			uint64_t generation;
+		};
+
+	public:
+		const_iterator begin() const { return entries.cbegin(); }
+		const_iterator end() const { return entries.cend(); }
+		const_iterator find(const std::string& key) const {
+			const int idx = FindIndex(key);
+			return ((idx < 0)? end(): (begin() + idx));
+		}
+
+		size_t size() const { return entries.size(); }
+		bool empty() const { return entries.empty(); }
+
+		/// stores <param> under <key>, advancing its generation only if its value or los changed;
+		/// narrowing its los also remembers it as removed under the old los
+		void Set(const std::string& key, Param param);
+		/// removes <key> (if present) and remembers it as removed at the current generation
+		void Erase(const std::string& key);
+
+		/// oldest first; only the last MAX_REMOVED_SIZE removals are kept
+		const std::vector<RemovedEntry>& GetRemoved() const { return removed; }
+		/// whether GetRemoved still holds every removal made after <generation>
+		bool HasRemovedSince(uint64_t generation) const { return (generation >= prunedGeneration); }
+
+		void PostLoad();
+
+	private:
+		int FindIndex(const std::string& key) const;
+		void RebuildIndex();
+		void PushRemoved(RemovedEntry&& entry);
+
+	private:
+		std::vector<Entry> entries;
+		// parallel to entries
+		std::vector<uint32_t> keyHashes;
+
+		spring::unordered_map<std::string, uint32_t> keyIndex;
+
+		std::vector<RemovedEntry> removed;
+
+		// generation of the newest removal dropped from <removed>
+		uint64_t prunedGeneration = 0;
+	};
 }
 
 #endif // LUA_RULESPARAMS_H
@@ -736,6 +736,8 @@ static int SetSolidObjectPieceCollisionVolumeData(lua_State* L, CSolidObject* ob
 	// piece volumes are not allowed to use discrete hit-testing
 	vol->InitShape(scales, offset, vType, CollisionVolume::COLVOL_HITTEST_CONT, pAxis);
 	vol->SetIgnoreHits(!luaL_checkboolean(L, 3));
+
+	obj->localModel.SetPieceBVHNeedsRefit();
 	return 0;
 }
 
@@ -1304,8 +1306,13 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	const int losIndex = offset + 3; // table
 
 	const std::string& key = luaL_checkstring(L, index);
+	const auto it = params.find(key);
+
+	// work on a copy, Set only marks the param as changed if it differs
+	LuaRulesParams::Param param;
 
-	LuaRulesParams::Param& param = params[key];
+	if (it != params.end())
+		param.los = it->second.los;
 
 	// set the value of the parameter
 	if (lua_israwnumber(L, valIndex)) {
@@ -1315,10 +1322,10 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else if (lua_isstring(L, valIndex)) {
 		param.value.emplace <std::string> (lua_tostring(L, valIndex));
 	} else if (lua_isnoneornil(L, valIndex)) {
-		params.erase(key);
+		params.Erase(key);
 		return; //no need to set los if param was erased
 	} else {
-		params.erase(key);
+		params.Erase(key);
 		luaL_error(L, "Incorrect arguments to %s()", caller);
 	}
 
@@ -1350,6 +1357,8 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else {
 		param.los = luaL_optint(L, losIndex, param.los);
 	}
+
+	params.Set(key, std::move(param));
 }
 
 
@@ -232,6 +232,9 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetUnitDirection);
 	REGISTER_LUA_CFUNC(GetUnitHeading);
 	REGISTER_LUA_CFUNC(GetUnitVelocity);
+	REGISTER_LUA_CFUNC(GetUnitArrayPosition);
+	REGISTER_LUA_CFUNC(GetUnitArrayHealth);
+	REGISTER_LUA_CFUNC(GetUnitArrayVelocity);
 	REGISTER_LUA_CFUNC(GetUnitBuildFacing);
 	REGISTER_LUA_CFUNC(GetUnitIsBuilding);
 	REGISTER_LUA_CFUNC(GetUnitWorkerTask);
@@ -644,6 +647,117 @@ static inline const CUnit* ParseTypedUnit(lua_State* L, const char* caller, int
 }
 
 
+
+/******************************************************************************/
+/******************************************************************************/
+//
+//  Bulk unit-array helpers
+//
+
+// same visibility rules as LuaUtils::IsUnit{Visible,InLos}, but with
+// the handle's read-access resolved once per call instead of per unit
+struct UnitArrayReader {
+	explicit UnitArrayReader(lua_State* L)
+	: readAllyTeam(CLuaHandle::GetHandleReadAllyTeam(L))
+	, fullRead(CLuaHandle::GetHandleFullRead(L))
+	{}
+
+	bool IsAllyUnit(const CUnit* unit) const {
+		if (readAllyTeam < 0)
+			return fullRead;
+
+		return (unit->allyteam == readAllyTeam);
+	}
+
+	bool HasLosStatus(const CUnit* unit, unsigned short losMask) const {
+		if (IsAllyUnit(unit))
+			return true;
+		if (readAllyTeam < 0)
+			return false;
+
+		return ((unit->losStatus[readAllyTeam] & losMask) != 0);
+	}
+
+	int readAllyTeam;
+	bool fullRead;
+};
+
+// one unit's slice of the flat output array
+struct UnitArrayRow {
+	void Set(int field, float value) const { lua_pushnumber(L, value); lua_rawseti(L, -2, base + field); }
+	void Nil(int field) const { lua_pushnil(L); lua_rawseti(L, -2, base + field); }
+
+	lua_State* L;
+	int base;
+};
+
+/*
+ * Expects an array of unitIDs at stack index 1 and an optional table to
+ * reuse at <outIndex>; writes <numFields> values per input unitID into a
+ * flat array (unitIDs[i] maps to entries (i - 1) * numFields + 1 through
+ * i * numFields) via <pushRow>. Entries of units that do not exist or are
+ * not visible to the caller (per <losMask>) are set to nil, as are any
+ * numeric keys past numUnits * numFields, so a reused table never carries
+ * stale values. Returns the table and the number of units that passed.
+ */
+template<typename PushRow>
+static int PushUnitArrayFields(lua_State* L, const char* caller, int outIndex, int numFields, unsigned short losMask, PushRow&& pushRow)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	const int numUnits = lua_objlen(L, 1);
+	const UnitArrayReader reader(L);
+
+	if (lua_istable(L, outIndex)) {
+		lua_pushvalue(L, outIndex);
+
+		// drop entries past our range left over from an earlier, larger call;
+		// rows of nils make lua_objlen unreliable here so walk the keys instead
+		// (clearing fields that already exist is allowed during traversal)
+		for (lua_pushnil(L); lua_next(L, -2) != 0; ) {
+			lua_pop(L, 1);
+
+			if (lua_type(L, -1) != LUA_TNUMBER || lua_tonumber(L, -1) <= (numUnits * numFields))
+				continue;
+
+			lua_pushvalue(L, -1);
+			lua_pushnil(L);
+			lua_rawset(L, -4);
+		}
+	} else {
+		lua_createtable(L, numUnits * numFields, 0);
+	}
+
+	int numValid = 0;
+
+	for (int i = 1; i <= numUnits; i++) {
+		lua_rawgeti(L, 1, i);
+
+		if (!lua_isnumber(L, -1))
+			luaL_error(L, "[%s] unitID (index #%d) not a number\n", caller, i);
+
+		const CUnit* unit = unitHandler.GetUnit(lua_toint(L, -1));
+		const UnitArrayRow row = {L, (i - 1) * numFields + 1};
+
+		lua_pop(L, 1);
+
+		if (unit == nullptr || !reader.HasLosStatus(unit, losMask)) {
+			for (int j = 0; j < numFields; j++) {
+				row.Nil(j);
+			}
+
+			continue;
+		}
+
+		pushRow(reader, unit, row);
+		numValid += 1;
+	}
+
+	lua_pushnumber(L, numValid);
+	return 2;
+}
+
+
 static const CFeature* ParseFeature(lua_State* L, const char* caller, int index)
 {
 	if (!lua_isnumber(L, index)) {
@@ -693,15 +807,26 @@ static inline const CTeam* ParseTeam(lua_State* L, const char* caller, int index
 
 static int PushRulesParams(lua_State* L, const char* caller,
                           const LuaRulesParams::Params& params,
-                          const int losStatus)
+                          const int losStatus,
+                          const int genIndex)
 {
-	lua_createtable(L, 0, params.size());
+	// with a generation, only params changed (or removed) after it are returned
+	const bool incremental = lua_isnumber(L, genIndex);
+	const uint64_t reqGen = incremental? static_cast<uint64_t>(std::max(lua_tonumber(L, genIndex), lua_Number(0))): 0;
+
+	// too many removals since <reqGen> to list them all, fall back to a full read
+	const bool removedKnown = params.HasRemovedSince(reqGen);
+	const uint64_t sinceGen = reqGen * removedKnown;
+
+	lua_createtable(L, 0, (sinceGen != 0)? 0: params.size());
 
 	for (const auto& it: params) {
 		const std::string& name = it.first;
 		const LuaRulesParams::Param& param = it.second;
 		if (!(param.los & losStatus))
 			continue;
+		if (param.generation <= sinceGen)
+			continue;
 
 		std::visit ([L, &name](auto&& value) {
 			using T = std::decay_t <decltype(value)>;
@@ -714,7 +839,37 @@ static int PushRulesParams(lua_State* L, const char* caller,
 		}, param.value);
 	}
 
-	return 1;
+	if (!incremental)
+		return 1;
+
+	lua_pushnumber(L, LuaRulesParams::GetGeneration());
+
+	if (!removedKnown) {
+		lua_pushnil(L);
+		return 3;
+	}
+
+	lua_newtable(L);
+
+	int numRemoved = 0;
+
+	for (const auto& entry: params.GetRemoved()) {
+		if (!(entry.los & losStatus))
+			continue;
+		if (entry.generation <= sinceGen)
+			continue;
+
+		// re-added (or still readable after a los change), already returned above
+		const auto it = params.find(entry.key);
+
+		if (it != params.end() && (it->second.los & losStatus))
+			continue;
+
+		lua_pushsstring(L, entry.key);
+		lua_rawseti(L, -2, ++numRemoved);
+	}
+
+	return 3;
 }
 
 
@@ -968,12 +1123,19 @@ int LuaSyncedRead::GetWind(lua_State* L)
  *
  * @function Spring.GetGameRulesParams
  *
+ * @tparam[opt] number sinceGeneration if given, only params changed (or removed) after this generation are returned;
+ *   pass 0 for a full read that also returns the generation, and do one whenever the caller's view of the params
+ *   may have changed (e.g. when an enemy unit enters LOS)
+ *
  * @treturn {[string] = number,...} rulesParams map with rules names as key and values as values
+ * @treturn nil|number generation only if sinceGeneration was given; pass to a later call to only get the params changed since this one
+ * @treturn nil|{string,...} removed names of params removed (or no longer readable) since sinceGeneration, only if it was given; nil if more were
+ *   removed since than are remembered, rulesParams then holds all params and should replace the caller's copy
  */
 int LuaSyncedRead::GetGameRulesParams(lua_State* L)
 {
 	// always readable for all
-	return PushRulesParams(L, __func__, CSplitLuaHandle::GetGameParams(), LuaRulesParams::RULESPARAMLOS_PRIVATE_MASK);
+	return PushRulesParams(L, __func__, CSplitLuaHandle::GetGameParams(), LuaRulesParams::RULESPARAMLOS_PRIVATE_MASK, 1);
 }
 
 
@@ -982,8 +1144,14 @@ int LuaSyncedRead::GetGameRulesParams(lua_State* L)
  * @function Spring.GetTeamRulesParams
  *
  * @tparam number teamID
+ * @tparam[opt] number sinceGeneration if given, only params changed (or removed) after this generation are returned;
+ *   pass 0 for a full read that also returns the generation, and do one whenever the caller's view of the params
+ *   may have changed (e.g. when an enemy unit enters LOS)
  *
  * @treturn {[string] = number,...} rulesParams map with rules names as key and values as values
+ * @treturn nil|number generation only if sinceGeneration was given; pass to a later call to only get the params changed since this one
+ * @treturn nil|{string,...} removed names of params removed (or no longer readable) since sinceGeneration, only if it was given; nil if more were
+ *   removed since than are remembered, rulesParams then holds all params and should replace the caller's copy
  */
 int LuaSyncedRead::GetTeamRulesParams(lua_State* L)
 {
@@ -1000,7 +1168,7 @@ int LuaSyncedRead::GetTeamRulesParams(lua_State* L)
 		losMask |= LuaRulesParams::RULESPARAMLOS_ALLIED_MASK;
 	}
 
-	return PushRulesParams(L, __func__, team->modParams, losMask);
+	return PushRulesParams(L, __func__, team->modParams, losMask, 2);
 }
 
 /***
@@ -1008,8 +1176,14 @@ int LuaSyncedRead::GetTeamRulesParams(lua_State* L)
  * @function Spring.GetPlayerRulesParams
  *
  * @tparam number playerID
+ * @tparam[opt] number sinceGeneration if given, only params changed (or removed) after this generation are returned;
+ *   pass 0 for a full read that also returns the generation, and do one whenever the caller's view of the params
+ *   may have changed (e.g. when an enemy unit enters LOS)
  *
  * @treturn {[string] = number,...} rulesParams map with rules names as key and values as values
+ * @treturn nil|number generation only if sinceGeneration was given; pass to a later call to only get the params changed since this one
+ * @treturn nil|{string,...} removed names of params removed (or no longer readable) since sinceGeneration, only if it was given; nil if more were
+ *   removed since than are remembered, rulesParams then holds all params and should replace the caller's copy
  */
 int LuaSyncedRead::GetPlayerRulesParams(lua_State* L)
 {
@@ -1047,7 +1221,7 @@ int LuaSyncedRead::GetPlayerRulesParams(lua_State* L)
 		losMask = LuaRulesParams::RULESPARAMLOS_PUBLIC_MASK;
 	}
 
-	return PushRulesParams(L, __func__, player->modParams, losMask);
+	return PushRulesParams(L, __func__, player->modParams, losMask, 2);
 }
 
 
@@ -1077,8 +1251,14 @@ static int GetUnitRulesParamLosMask(lua_State* L, const CUnit* unit)
  * @function Spring.GetUnitRulesParams
  *
  * @tparam number unitID
+ * @tparam[opt] number sinceGeneration if given, only params changed (or removed) after this generation are returned;
+ *   pass 0 for a full read that also returns the generation, and do one whenever the caller's view of the params
+ *   may have changed (e.g. when an enemy unit enters LOS)
  *
  * @treturn {[string] = number,...} rulesParams map with rules names as key and values as values
+ * @treturn nil|number generation only if sinceGeneration was given; pass to a later call to only get the params changed since this one
+ * @treturn nil|{string,...} removed names of params removed (or no longer readable) since sinceGeneration, only if it was given; nil if more were
+ *   removed since than are remembered, rulesParams then holds all params and should replace the caller's copy
  */
 int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
 {
@@ -1086,7 +1266,7 @@ int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
 	if (unit == nullptr || game == nullptr)
 		return 0;
 
-	return PushRulesParams(L, __func__, unit->modParams, GetUnitRulesParamLosMask(L, unit));
+	return PushRulesParams(L, __func__, unit->modParams, GetUnitRulesParamLosMask(L, unit), 2);
 }
 
 
@@ -1095,8 +1275,14 @@ int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
  * @function Spring.GetFeatureRulesParams
  *
  * @tparam number featureID
+ * @tparam[opt] number sinceGeneration if given, only params changed (or removed) after this generation are returned;
+ *   pass 0 for a full read that also returns the generation, and do one whenever the caller's view of the params
+ *   may have changed (e.g. when an enemy unit enters LOS)
  *
  * @treturn {[string] = number,...} rulesParams map with rules names as key and values as values
+ * @treturn nil|number generation only if sinceGeneration was given; pass to a later call to only get the params changed since this one
+ * @treturn nil|{string,...} removed names of params removed (or no longer readable) since sinceGeneration, only if it was given; nil if more were
+ *   removed since than are remembered, rulesParams then holds all params and should replace the caller's copy
  */
 int LuaSyncedRead::GetFeatureRulesParams(lua_State* L)
 {
@@ -1122,7 +1308,7 @@ int LuaSyncedRead::GetFeatureRulesParams(lua_State* L)
 
 	const LuaRulesParams::Params&  params = feature->modParams;
 
-	return PushRulesParams(L, __func__, params, losMask);
+	return PushRulesParams(L, __func__, params, losMask, 2);
 }
 
 
@@ -4511,6 +4697,86 @@ int LuaSyncedRead::GetUnitVelocity(lua_State* L)
 }
 
 
+/***
+ * Bulk version of Spring.GetUnitPosition, for callers that need the positions of many units at once.
+ *
+ * @function Spring.GetUnitArrayPosition
+ * @tparam {number,...} unitIDs
+ * @bool[opt=false] midPos return midpoints instead of basepoints
+ * @tparam[opt] {number,...} out table to fill and return instead of a new one
+ * @treturn {number,...} positions flat array of x, y, z triples, one per entry of unitIDs (nil for units that are not visible)
+ * @treturn number numUnits number of visible units
+ */
+int LuaSyncedRead::GetUnitArrayPosition(lua_State* L)
+{
+	const bool midPos = luaL_optboolean(L, 2, false);
+
+	return (PushUnitArrayFields(L, __func__, 3, 3, LOS_INLOS | LOS_INRADAR, [&](const UnitArrayReader& reader, const CUnit* unit, const UnitArrayRow& row) {
+		float3 pos = midPos? float3(unit->midPos): float3(unit->pos);
+
+		if (!reader.IsAllyUnit(unit))
+			pos += unit->GetLuaErrorVector(reader.readAllyTeam, reader.fullRead);
+
+		row.Set(0, pos.x);
+		row.Set(1, pos.y);
+		row.Set(2, pos.z);
+	}));
+}
+
+
+/***
+ * Bulk version of Spring.GetUnitHealth, for callers that need the health of many units at once.
+ *
+ * @function Spring.GetUnitArrayHealth
+ * @tparam {number,...} unitIDs
+ * @tparam[opt] {number,...} out table to fill and return instead of a new one
+ * @treturn {number,...} healths flat array of health, maxHealth, paralyzeDamage, captureProgress, buildProgress tuples, one per entry of unitIDs (nil for units not in LOS)
+ * @treturn number numUnits number of units in LOS
+ */
+int LuaSyncedRead::GetUnitArrayHealth(lua_State* L)
+{
+	return (PushUnitArrayFields(L, __func__, 2, 5, LOS_INLOS, [&](const UnitArrayReader& reader, const CUnit* unit, const UnitArrayRow& row) {
+		const UnitDef* ud = unit->unitDef;
+		const bool enemyUnit = !reader.IsAllyUnit(unit);
+
+		if (ud->hideDamage && enemyUnit) {
+			row.Nil(0);
+			row.Nil(1);
+			row.Nil(2);
+		} else {
+			const float scale = (enemyUnit && ud->decoyDef != nullptr)? (ud->decoyDef->health / ud->health): 1.0f;
+
+			row.Set(0, scale * unit->health);
+			row.Set(1, scale * unit->maxHealth);
+			row.Set(2, scale * unit->paralyzeDamage);
+		}
+
+		row.Set(3, unit->captureProgress);
+		row.Set(4, unit->buildProgress);
+	}));
+}
+
+
+/***
+ * Bulk version of Spring.GetUnitVelocity, for callers that need the velocities of many units at once.
+ *
+ * @function Spring.GetUnitArrayVelocity
+ * @tparam {number,...} unitIDs
+ * @tparam[opt] {number,...} out table to fill and return instead of a new one
+ * @treturn {number,...} velocities flat array of x, y, z, speed tuples, one per entry of unitIDs (nil for units not in LOS)
+ * @treturn number numUnits number of units in LOS
+ */
+int LuaSyncedRead::GetUnitArrayVelocity(lua_State* L)
+{
+	return (PushUnitArrayFields(L, __func__, 2, 4, LOS_INLOS, [](const UnitArrayReader&, const CUnit* unit, const UnitArrayRow& row) {
+		row.Set(0, unit->speed.x);
+		row.Set(1, unit->speed.y);
+		row.Set(2, unit->speed.z);
+		row.Set(3, unit->speed.w);
+	}));
+}
+
+
 /***
  *
  * @function Spring.GetUnitBuildFacing
@@ -1234,6 +1234,29 @@ int LuaUtils::Next(const ParamMap& paramMap, lua_State* L)
 }
 
 
+void LuaUtils::PushParamMapKeys(lua_State* L, const ParamMap& paramMap)
+{
+	lua_createtable(L, 0, paramMap.size());
+
+	for (const auto& [key, elem]: paramMap) {
+		lua_pushsstring(L, key);
+		new (lua_newuserdata(L, sizeof(DataElement))) DataElement(elem);
+		lua_rawset(L, -3);
+	}
+}
+
+const DataElement* LuaUtils::FindParam(lua_State* L, int keyIndex, int keysTableIndex)
+{
+	lua_pushvalue(L, keyIndex);
+	lua_rawget(L, keysTableIndex);
+
+	const DataElement* elem = static_cast<const DataElement*>(lua_touserdata(L, -1));
+
+	lua_pop(L, 1);
+	return elem;
+}
+
+
 /******************************************************************************/
 /******************************************************************************/
 
@@ -145,6 +145,12 @@ class LuaUtils {
 		// from LuaFeatureDefs.cpp / LuaUnitDefs.cpp / LuaWeaponDefs.cpp
 		// (helper for the Next() iteration routine)
 		static int Next(const ParamMap& paramMap, lua_State* L);
+		// pushes a table mapping every key of paramMap to a copy of its
+		// element; the def proxies of a state share it so their metatable
+		// calls can look keys up by the interned Lua string instead of
+		// hashing a std::string on every access
+		static void PushParamMapKeys(lua_State* L, const ParamMap& paramMap);
+		static const DataElement* FindParam(lua_State* L, int keyIndex, int keysTableIndex);
 
 		// from LuaParser.cpp / LuaUnsyncedCtrl.cpp
 		// (implementation copied from lua/src/lib/lbaselib.c)
@@ -219,7 +225,8 @@ static void PushObjectDefProxyTable(
 	const std::array<const LuaHashString, iterFuncsSize>& iterOpers,
 	const std::array<const lua_CFunction, indxFuncsSize>& indxFuncs,
 	const std::array<const lua_CFunction, iterFuncsSize>& iterFuncs,
-	const ObjectDefType* def
+	const ObjectDefType* def,
+	int keysTableIndex // absolute, see LuaUtils::PushParamMapKeys
 ) {
 	lua_pushnumber(L, def->id);
 	lua_createtable(L, 0, iterFuncsSize); { // the proxy table
@@ -229,7 +236,8 @@ static void PushObjectDefProxyTable(
 		for (size_t n = 0; n < indxFuncsSize; n++) {
 			indxOpers[n].Push(L);
 			lua_pushlightuserdata(L, (void*) def);
-			lua_pushcclosure(L, indxFuncs[n], 1);
+			lua_pushvalue(L, keysTableIndex);
+			lua_pushcclosure(L, indxFuncs[n], 2);
 			lua_rawset(L, -3); // closure
 		}
 
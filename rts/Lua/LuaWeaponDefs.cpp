@@ -76,6 +76,12 @@ bool LuaWeaponDefs::PushEntries(lua_State* L)
 	const std::array<const IndxFuncType, 3> indxFuncs = {{WeaponDefIndex, WeaponDefNewIndex, WeaponDefMetatable}};
 	const std::array<const IterFuncType, 2> iterFuncs = {{Pairs, Next}};
 
+	// shared by all proxies, keeps the defs table on top for their rawset
+	LuaUtils::PushParamMapKeys(L, paramMap);
+	lua_insert(L, -2);
+
+	const int keysTableIndex = lua_gettop(L) - 1;
+
 	for (const auto& weaponDef: defsVec) {
 		// The first weaponDef is invalid (dummy), so we skip it
 		const auto def = weaponDefHandler->GetWeaponDefByID(weaponDef.id);
@@ -83,9 +89,11 @@ bool LuaWeaponDefs::PushEntries(lua_State* L)
 		if (def == nullptr)
 			continue;
 
-		PushObjectDefProxyTable(L, indxOpers, iterOpers, indxFuncs, iterFuncs, def);
+		PushObjectDefProxyTable(L, indxOpers, iterOpers, indxFuncs, iterFuncs, def, keysTableIndex);
 	}
 
+	lua_remove(L, keysTableIndex);
+
 	return true;
 }
 
@@ -101,19 +109,18 @@ static int WeaponDefIndex(lua_State* L)
 	}
 
 	const char* name = lua_tostring(L, 2);
-	ParamMap::const_iterator it = paramMap.find(name);
+	const DataElement* elem = LuaUtils::FindParam(L, 2, lua_upvalueindex(2));
 
 	// not a default value
-	if (it == paramMap.end()) {
+	if (elem == nullptr) {
 		lua_rawget(L, 1);
 		return 1;
 	}
 
 	const void* userData = lua_touserdata(L, lua_upvalueindex(1));
 	const WeaponDef* wd = static_cast<const WeaponDef*>(userData);
-	const DataElement& elem = it->second;
-	const void* p = ((const char*)wd) + elem.offset;
-	switch (elem.type) {
+	const void* p = ((const char*)wd) + elem->offset;
+	switch (elem->type) {
 		case READONLY_TYPE: {
 			lua_rawget(L, 1);
 			return 1;
@@ -135,7 +142,7 @@ static int WeaponDefIndex(lua_State* L)
 			return 1;
 		}
 		case FUNCTION_TYPE: {
-			return elem.func(L, p);
+			return elem->func(L, p);
 		}
 		case ERROR_TYPE: {
 			LOG_L(L_ERROR, "[%s] ERROR_TYPE for key \"%s\" in WeaponDefs __index", __func__, name);
@@ -157,10 +164,10 @@ static int WeaponDefNewIndex(lua_State* L)
 	}
 
 	const char* name = lua_tostring(L, 2);
-	ParamMap::const_iterator it = paramMap.find(name);
+	const DataElement* elem = LuaUtils::FindParam(L, 2, lua_upvalueindex(2));
 
 	// not a default value, set it
-	if (it == paramMap.end()) {
+	if (elem == nullptr) {
 		lua_rawset(L, 1);
 		return 0;
 	}
@@ -175,10 +182,9 @@ static int WeaponDefNewIndex(lua_State* L)
 	}
 
 	// Definition editing
-	const DataElement& elem = it->second;
-	const void* p = ((const char*)wd) + elem.offset;
+	const void* p = ((const char*)wd) + elem->offset;
 
-	switch (elem.type) {
+	switch (elem->type) {
 		case FUNCTION_TYPE:
 		case READONLY_TYPE: {
 			luaL_error(L, "Can not write to %s", name);
@@ -7,6 +7,10 @@
 #include "Sim/Misc/GlobalSynced.h"
 #include "System/SpringMath.h"
 
+#include "xsimd/xsimd.hpp"
+
+#include <array>
+#include <bit>
 #include <cassert>
 #include <limits>
 
@@ -149,6 +153,144 @@ static inline float LineGroundSquareCol(
 
 
 
+// hierarchical variant of the square-by-square walk in LineGroundCol
+// the ray is tested against a quadtree whose nodes are the texels of
+// the max-height mips; whole nodes whose maximum height lies below the
+// ray's lowest point over the node's xz-extent are skipped, and only
+// the nodes the ray comes close to are refined down to single squares
+// nodes above the coarsest mip are "virtual" and only clip to the map
+struct LineGroundHierarchicalCol {
+public:
+	LineGroundHierarchicalCol(const float* hm, const float3* nm, const float3& from, const float3& to)
+		: heightMap(hm)
+		, normalMap(nm)
+		, rayFrom(from)
+		, rayTo(to)
+		, rayDir(to - from)
+		, rayInvDir((rayDir.x != 0.0f)? (1.0f / rayDir.x): 0.0f, (rayDir.z != 0.0f)? (1.0f / rayDir.z): 0.0f)
+	{
+		for (int i = 0; i < CReadMap::numHeightMipMaps; i++) {
+			maxHeightMips[i] = readMap->GetMIPMaxHeightMapSynced(i);
+		}
+
+		rootLevel = std::bit_width(static_cast<uint32_t>(std::max(mapDims.pwr2mapx, mapDims.pwr2mapy))) - 1;
+	}
+
+	// the mips only cover the full map if its dimensions are divisible by
+	// the coarsest mip's texel size, otherwise border squares would never
+	// contribute to a max-texel and could be skipped incorrectly
+	static bool CanUseMips() {
+		constexpr int mask = (1 << (CReadMap::numHeightMipMaps - 1)) - 1;
+		return ((mapDims.mapx & mask) == 0 && (mapDims.mapy & mask) == 0);
+	}
+
+	float Trace() const { return (TraceNode(rootLevel, 0, 0, 0.0f, 1.0f)); }
+
+private:
+	// parametric [tEnter, tExit] interval of the ray within the xz-extent of node (nx, nz) at <level>
+	bool ClipNode(int level, int nx, int nz, float& tEnter, float& tExit) const {
+		const float nodeSize = (1 << level) * SQUARE_SIZE;
+
+		const float minx = nx * nodeSize;
+		const float minz = nz * nodeSize;
+
+		tEnter = 0.0f;
+		tExit  = 1.0f;
+
+		if (!ClipAxis(rayFrom.x, rayDir.x, rayInvDir.x, minx, minx + nodeSize, tEnter, tExit))
+			return false;
+		if (!ClipAxis(rayFrom.z, rayDir.z, rayInvDir.y, minz, minz + nodeSize, tEnter, tExit))
+			return false;
+
+		return true;
+	}
+
+	static bool ClipAxis(float p, float d, float rd, float minp, float maxp, float& tEnter, float& tExit) {
+		if (d == 0.0f)
+			return (p >= minp && p <= maxp);
+
+		float t0 = (minp - p) * rd;
+		float t1 = (maxp - p) * rd;
+
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tEnter = std::max(tEnter, t0);
+		tExit  = std::min(tExit , t1);
+		return (tEnter <= tExit);
+	}
+
+	float TraceNode(int level, int nx, int nz, float tEnter, float tExit) const {
+		if (level < CReadMap::numHeightMipMaps) {
+			// lowest point of the ray inside this node (it is a line, so always at either end)
+			const float rayMinHeight = rayFrom.y + rayDir.y * ((rayDir.y < 0.0f)? tExit: tEnter);
+			const float nodeMaxHeight = maxHeightMips[level][nz * (mapDims.mapx >> level) + nx];
+
+			// small bias absorbs precision differences wrt LineGroundSquareCol
+			if (rayMinHeight > (nodeMaxHeight + 0.01f))
+				return -1.0f;
+
+			if (level == 0)
+				return (LineGroundSquareCol(heightMap, normalMap,  rayFrom, rayTo,  nx, nz));
+		}
+
+		struct ChildNode {
+			int x;
+			int z;
+			float tEnter;
+			float tExit;
+		};
+
+		std::array<ChildNode, 4> children;
+		size_t numChildren = 0;
+
+		const int childLevel = level - 1;
+		const int childSizeSqrs = 1 << childLevel;
+
+		for (int i = 0; i < 4; i++) {
+			ChildNode c = {nx * 2 + (i & 1), nz * 2 + (i >> 1), 0.0f, 0.0f};
+
+			if ((c.x * childSizeSqrs) >= mapDims.mapx || (c.z * childSizeSqrs) >= mapDims.mapy)
+				continue;
+			if (!ClipNode(childLevel, c.x, c.z, c.tEnter, c.tExit))
+				continue;
+
+			// insertion-sort by entry distance so children are visited front to back
+			size_t j = numChildren++;
+
+			for (; j > 0 && children[j - 1].tEnter > c.tEnter; j--) {
+				children[j] = children[j - 1];
+			}
+
+			children[j] = c;
+		}
+
+		for (size_t i = 0; i < numChildren; i++) {
+			const ChildNode& c = children[i];
+			const float ret = TraceNode(childLevel, c.x, c.z, c.tEnter, c.tExit);
+
+			if (ret >= 0.0f)
+				return ret;
+		}
+
+		return -1.0f;
+	}
+
+private:
+	const float* heightMap;
+	const float3* normalMap;
+	std::array<const float*, CReadMap::numHeightMipMaps> maxHeightMips;
+
+	const float3 rayFrom;
+	const float3 rayTo;
+	const float3 rayDir;
+	const float2 rayInvDir;
+
+	int rootLevel = 0;
+};
+
+
+
 /*
 void CGround::CheckColSquare(CProjectile* p, int x, int y)
 {
@@ -249,6 +391,17 @@ float CGround::LineGroundCol(float3 from, float3 to, bool synced)
 			return 0.0f + skippedDist;
 	}
 
+	// the max-height mips are derived from the synced heightmap only, the
+	// unsynced one can lag behind (or run ahead of) it and is walked below
+	if (synced && LineGroundHierarchicalCol::CanUseMips()) {
+		const float ret = LineGroundHierarchicalCol(hm, nm,  from, to).Trace();
+
+		if (ret >= 0.0f)
+			return (ret + skippedDist);
+
+		return -1.0f;
+	}
+
 	const float dx = to.x - from.x;
 	const float dz = to.z - from.z;
 	const int dirx = (dx > 0.0f) ? 1 : -1;
@@ -470,6 +623,84 @@ float CGround::GetHeightReal(float x, float z, bool synced)
 	return InterpolateCornerHeight(x, z, readMap->GetSharedCornerHeightMap(synced));
 }
 
+void CGround::GetHeightsReal(const float* xs, const float* zs, float* hs, size_t count, bool synced)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using FloatBatch = xsimd::simd_type<float>;
+	using IntBatch = xsimd::simd_type<int32_t>;
+
+	constexpr size_t N = FloatBatch::size;
+	static_assert(IntBatch::size == N);
+
+	const float* cornerHeightMap = readMap->GetSharedCornerHeightMap(synced);
+
+	const FloatBatch zero(0.0f);
+	const FloatBatch one(1.0f);
+	const FloatBatch sqrSize(SQUARE_SIZE);
+	const FloatBatch maxxpos(float3::maxxpos);
+	const FloatBatch maxzpos(float3::maxzpos);
+	const IntBatch mapxp1(mapDims.mapxp1);
+
+	alignas(64) int32_t idx[N];
+	alignas(64) float h00[N];
+	alignas(64) float h10[N];
+	alignas(64) float h01[N];
+	alignas(64) float h11[N];
+
+	size_t i = 0;
+
+	// same arithmetic (and evaluation order) as InterpolateCornerHeight so
+	// results stay in sync with the scalar path, except that both triangles
+	// are evaluated and the right one is selected per lane
+	for (; (i + N) <= count; i += N) {
+		FloatBatch x;
+		FloatBatch z;
+
+		x.load_unaligned(xs + i);
+		z.load_unaligned(zs + i);
+
+		x = xsimd::min(xsimd::max(x, zero), maxxpos) / sqrSize;
+		z = xsimd::min(xsimd::max(z, zero), maxzpos) / sqrSize;
+
+		const IntBatch ix = xsimd::to_int(x);
+		const IntBatch iz = xsimd::to_int(z);
+
+		const FloatBatch dx = x - xsimd::to_float(ix);
+		const FloatBatch dz = z - xsimd::to_float(iz);
+
+		(ix + iz * mapxp1).store_aligned(idx);
+
+		// no gather instructions on the baseline targets
+		for (size_t j = 0; j < N; j++) {
+			const float* corners = &cornerHeightMap[idx[j]];
+
+			h00[j] = corners[0                 ];
+			h10[j] = corners[1                 ];
+			h01[j] = corners[0 + mapDims.mapxp1];
+			h11[j] = corners[1 + mapDims.mapxp1];
+		}
+
+		FloatBatch b00;
+		FloatBatch b10;
+		FloatBatch b01;
+		FloatBatch b11;
+
+		b00.load_aligned(h00);
+		b10.load_aligned(h10);
+		b01.load_aligned(h01);
+		b11.load_aligned(h11);
+
+		const FloatBatch htl = b00 + dx * (b10 - b00) + dz * (b01 - b00);
+		const FloatBatch hbr = b11 + (one - dx) * (b01 - b11) + (one - dz) * (b10 - b11);
+
+		xsimd::select((dx + dz) < one, htl, hbr).store_unaligned(hs + i);
+	}
+
+	for (; i < count; i++) {
+		hs[i] = InterpolateCornerHeight(xs[i], zs[i], cornerHeightMap);
+	}
+}
+
 float CGround::GetOrigHeight(float x, float z)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -19,6 +19,8 @@ public:
 	/// Returns the real height at the specified position, can be below 0
 	static float GetHeightReal(float x, float z, bool synced = true);
 	static float GetOrigHeight(float x, float z);
+	/// batched GetHeightReal for SoA positions, hs[i] is bit-identical to GetHeightReal(xs[i], zs[i], synced)
+	static void GetHeightsReal(const float* xs, const float* zs, float* hs, size_t count, bool synced = true);
 
 	static consteval float GetWaterPlaneLevel() {
 		/* Water plane height is hardcoded currently.
@@ -65,6 +65,7 @@ CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(unsyncedHeightInfo),
 	CR_IGNORED(boundingRadius),
 	CR_IGNORED(mapChecksum),
+	CR_IGNORED(heightMapSyncedGeneration),
 
 	CR_IGNORED(heightMapSyncedPtr),
 	CR_IGNORED(heightMapUnsyncedPtr),
@@ -76,6 +77,7 @@ CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(mipCenterHeightMaps),
 	*/
 	CR_IGNORED(mipPointerHeightMaps),
+	CR_IGNORED(mipPointerMaxHeightMaps),
 	/*
 	CR_IGNORED(visVertexNormals),
 	CR_IGNORED(faceNormalsSynced),
@@ -116,6 +118,7 @@ std::vector<float> CReadMap::originalHeightMap;
 std::vector<float> CReadMap::centerHeightMap;
 std::vector<float> CReadMap::maxHeightMap;
 std::array<std::vector<float>, CReadMap::numHeightMipMaps - 1> CReadMap::mipCenterHeightMaps;
+std::array<std::vector<float>, CReadMap::numHeightMipMaps> CReadMap::mipMaxHeightMaps;
 
 std::vector<float3> CReadMap::visVertexNormals;
 std::vector<float3> CReadMap::faceNormalsSynced;
@@ -281,12 +284,19 @@ void CReadMap::PostLoad()
 
 	mipPointerHeightMaps.fill(nullptr);
 	mipPointerHeightMaps[0] = &centerHeightMap[0];
+	mipMaxHeightMaps[0].clear();
+	mipMaxHeightMaps[0].resize(mapDims.mapx * mapDims.mapy);
+	mipPointerMaxHeightMaps.fill(nullptr);
+	mipPointerMaxHeightMaps[0] = &mipMaxHeightMaps[0][0];
 
 	for (int i = 1; i < numHeightMipMaps; i++) {
 		mipCenterHeightMaps[i - 1].clear();
 		mipCenterHeightMaps[i - 1].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
+		mipMaxHeightMaps[i].clear();
+		mipMaxHeightMaps[i].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
 
 		mipPointerHeightMaps[i] = &mipCenterHeightMaps[i - 1][0];
+		mipPointerMaxHeightMaps[i] = &mipMaxHeightMaps[i][0];
 	}
 
 	hmUpdated = true;
@@ -330,11 +340,14 @@ void CReadMap::Initialize()
 			((  mapDims.hmapx     * mapDims.hmapy           * sizeof(float))         / 1024) +   // MetalMap::extractionMap
 			((  mapDims.hmapx     * mapDims.hmapy           * sizeof(unsigned char)) / 1024);    // MetalMap::metalMap
 
-		// mipCenterHeightMaps[i]
+		// mipCenterHeightMaps[i], mipMaxHeightMaps[i]
 		for (int i = 1; i < numHeightMipMaps; i++) {
-			reqMemFootPrintKB += ((((mapDims.mapx >> i) * (mapDims.mapy >> i)) * sizeof(float)) / 1024);
+			reqMemFootPrintKB += ((((mapDims.mapx >> i) * (mapDims.mapy >> i)) * 2 * sizeof(float)) / 1024);
 		}
 
+		// mipMaxHeightMaps[0]
+		reqMemFootPrintKB += ((mapDims.mapx * mapDims.mapy * sizeof(float)) / 1024);
+
 		sprintf(loadMsg, fmtString, reqMemFootPrintKB / 1024);
 		loadscreen->SetLoadMessage(loadMsg);
 	}
@@ -360,14 +373,21 @@ void CReadMap::Initialize()
 
 	mipPointerHeightMaps.fill(nullptr);
 	mipPointerHeightMaps[0] = &centerHeightMap[0];
+	mipMaxHeightMaps[0].clear();
+	mipMaxHeightMaps[0].resize(mapDims.mapx * mapDims.mapy);
+	mipPointerMaxHeightMaps.fill(nullptr);
+	mipPointerMaxHeightMaps[0] = &mipMaxHeightMaps[0][0];
 
 	originalHeightMapPtr = &originalHeightMap;
 
 	for (int i = 1; i < numHeightMipMaps; i++) {
 		mipCenterHeightMaps[i - 1].clear();
 		mipCenterHeightMaps[i - 1].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
+		mipMaxHeightMaps[i].clear();
+		mipMaxHeightMaps[i].resize((mapDims.mapx >> i) * (mapDims.mapy >> i));
 
 		mipPointerHeightMaps[i] = &mipCenterHeightMaps[i - 1][0];
+		mipPointerMaxHeightMaps[i] = &mipMaxHeightMaps[i][0];
 	}
 
 	slopeMap.clear();
@@ -525,6 +545,8 @@ void CReadMap::UpdateHeightMapSynced(const SRectangle& hgtMapRect)
 	RECOIL_DETAILED_TRACY_ZONE;
 	const bool initialize = (hgtMapRect == SRectangle{ 0, 0, mapDims.mapx, mapDims.mapy });
 
+	heightMapSyncedGeneration++;
+
 	const int2 mins = {hgtMapRect.x1 - 1, hgtMapRect.z1 - 1};
 	const int2 maxs = {hgtMapRect.x2 + 1, hgtMapRect.z2 + 1};
 
@@ -538,6 +560,7 @@ void CReadMap::UpdateHeightMapSynced(const SRectangle& hgtMapRect)
 
 	UpdateCenterHeightmap(centerRect, initialize);
 	UpdateMipHeightmaps(centerRect, initialize);
+	UpdateMipMaxHeightmaps(centerRect, initialize);
 	UpdateFaceNormals(centerRect, initialize);
 	UpdateSlopemap(centerRect, initialize); // must happen after UpdateFaceNormals()!
 
@@ -673,6 +696,88 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 }
 
 
+void CReadMap::UpdateMipMaxHeightmaps(const SRectangle& rect, bool initialize)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	// unlike the averaged mips these must stay conservative (used to skip
+	// terrain in CGround::LineGroundCol), so every texel touched by <rect>
+	// is rebuilt inclusively
+	// the base level is rebuilt from the corner heightmap rather than copied
+	// from maxHeightMap: squares of other, still pending rectangles are then
+	// left as RaiseMipMaxHeights made them instead of reverting to stale maxima
+	const float* heightmapSynced = GetCornerHeightMapSynced();
+
+	for (int y = rect.z1; y <= rect.z2; y++) {
+		for (int x = rect.x1; x <= rect.x2; x++) {
+			const int idxTL = (y + 0) * mapDims.mapxp1 + x + 0;
+			const int idxTR = (y + 0) * mapDims.mapxp1 + x + 1;
+			const int idxBL = (y + 1) * mapDims.mapxp1 + x + 0;
+			const int idxBR = (y + 1) * mapDims.mapxp1 + x + 1;
+
+			mipMaxHeightMaps[0][y * mapDims.mapx + x] = std::max(
+				std::max(heightmapSynced[idxTL], heightmapSynced[idxTR]),
+				std::max(heightmapSynced[idxBL], heightmapSynced[idxBR])
+			);
+		}
+	}
+
+	for (int i = 0; i < numHeightMipMaps - 1; i++) {
+		const int topx = mapDims.mapx >> (i    );
+		const int subx = mapDims.mapx >> (i + 1);
+		const int suby = mapDims.mapy >> (i + 1);
+
+		const int sx = rect.x1 >> (i + 1);
+		const int sy = rect.z1 >> (i + 1);
+		const int ex = std::min(rect.x2 >> (i + 1), subx - 1);
+		const int ey = std::min(rect.z2 >> (i + 1), suby - 1);
+
+		const float* topMipMap = mipPointerMaxHeightMaps[i    ];
+		      float* subMipMap = mipPointerMaxHeightMaps[i + 1];
+
+		for (int y = sy; y <= ey; y++) {
+			for (int x = sx; x <= ex; x++) {
+				const int tx = x * 2;
+				const int ty = y * 2;
+
+				subMipMap[x + y * subx] = std::max(
+					std::max(topMipMap[(tx    ) + (ty    ) * topx], topMipMap[(tx + 1) + (ty    ) * topx]),
+					std::max(topMipMap[(tx    ) + (ty + 1) * topx], topMipMap[(tx + 1) + (ty + 1) * topx])
+				);
+			}
+		}
+	}
+}
+
+void CReadMap::RaiseMipMaxHeights(const int idx, const float h)
+{
+	// not allocated yet while the map is loading, Initialize builds them
+	if (mipMaxHeightMaps[0].empty())
+		return;
+
+	const int cx = idx % mapDims.mapxp1;
+	const int cz = idx / mapDims.mapxp1;
+
+	// squares sharing corner <idx>
+	const int sx = std::max(cx - 1, 0);
+	const int sz = std::max(cz - 1, 0);
+	const int ex = std::min(cx, mapDims.mapxm1);
+	const int ez = std::min(cz, mapDims.mapym1);
+
+	for (int i = 0; i < numHeightMipMaps; i++) {
+		const int mipx = mapDims.mapx >> i;
+		const int mipy = mapDims.mapy >> i;
+
+		for (int z = sz >> i, mz = std::min(ez >> i, mipy - 1); z <= mz; z++) {
+			for (int x = sx >> i, mx = std::min(ex >> i, mipx - 1); x <= mx; x++) {
+				float& maxHeight = mipMaxHeightMaps[i][z * mipx + x];
+				maxHeight = std::max(maxHeight, h);
+			}
+		}
+	}
+}
+
+
+
 void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
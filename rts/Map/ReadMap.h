@@ -168,6 +168,7 @@ public:
 	const float* GetCenterHeightMapSynced() const { return &centerHeightMap[0]; }
 	const float* GetMaxHeightMapSynced() const { return &maxHeightMap[0]; }
 	const float* GetMIPHeightMapSynced(unsigned int mip) const { return mipPointerHeightMaps[mip]; }
+	const float* GetMIPMaxHeightMapSynced(unsigned int mip) const { return mipPointerMaxHeightMaps[mip]; }
 	const float* GetSlopeMapSynced() const { return &slopeMap[0]; }
 	const uint8_t* GetTypeMapSynced() const { return &typeMap[0]; }
 	      uint8_t* GetTypeMapSynced()       { return &typeMap[0]; }
@@ -196,6 +197,9 @@ public:
 	// Misc
 	void CopySyncedToUnsynced();
 
+	/// bumped on every synced heightmap change, lets callers cache terrain samples
+	uint32_t GetHeightMapSyncedGeneration() const { return heightMapSyncedGeneration; }
+
 	/// if you modify the heightmap through these, call UpdateHeightMapSynced
 	float SetHeight(const int idx, const float h, const int add = 0);
 	float AddHeight(const int idx, const float a);
@@ -236,6 +240,8 @@ private:
 
 	void UpdateCenterHeightmap(const SRectangle& rect, bool initialize) const;
 	void UpdateMipHeightmaps(const SRectangle& rect, bool initialize);
+	void UpdateMipMaxHeightmaps(const SRectangle& rect, bool initialize);
+	void RaiseMipMaxHeights(const int idx, const float h);
 	void UpdateFaceNormals(const SRectangle& rect, bool initialize);
 	void UpdateSlopemap(const SRectangle& rect, bool initialize);
 
@@ -263,6 +269,7 @@ protected:
 	static std::vector<float> centerHeightMap;          //< size: (mapx  )*(mapy  ) (per face) [SYNCED, updates on terrain deformation]
 	static std::array<std::vector<float>, numHeightMipMaps - 1> mipCenterHeightMaps;
 	static std::vector<float> maxHeightMap;			// map for sea/hover to catch coast lines with sharp vertical changes so they don't try to climb the cliff.
+	static std::array<std::vector<float>, numHeightMipMaps> mipMaxHeightMaps;
 
 	/**
 	 * array of pointers to heightmaps in different resolutions
@@ -271,6 +278,16 @@ protected:
 	 */
 	std::array<float*, numHeightMipMaps> mipPointerHeightMaps;
 
+	/**
+	 * same layout as mipPointerHeightMaps, but each texel stores the maximum
+	 * (rather than the average) corner height of all squares it covers, so a
+	 * ray passing above a texel can not intersect any terrain underneath it
+	 * mipPointerMaxHeightMaps[0] is full resolution (same values as maxHeightMap
+	 * once updated, but also raised immediately by SetHeight so the mips never
+	 * lag behind deformations waiting for UpdateHeightMapSynced)
+	 */
+	std::array<float*, numHeightMipMaps> mipPointerMaxHeightMaps;
+
 	static std::vector<float3> visVertexNormals;      //< size:  (mapx + 1) * (mapy + 1), contains one vertex normal per corner-heightmap pixel [UNSYNCED]
 	static std::vector<float3> faceNormalsSynced;     //< size: 2*mapx      *  mapy     , contains 2 normals per quad -> triangle strip [SYNCED]
 	static std::vector<float3> faceNormalsUnsynced;   //< size: 2*mapx      *  mapy     , contains 2 normals per quad -> triangle strip [UNSYNCED]
@@ -302,6 +319,7 @@ private:
 	static std::vector<uint8_t> unsyncedHeightMapDigests;
 
 	unsigned int mapChecksum = 0;
+	uint32_t heightMapSyncedGeneration = 0;
 
 	bool processingHeightBounds = false;
 	bool hmUpdated = false;
@@ -319,7 +337,15 @@ extern MapDimensions mapDims;
 
 inline float CReadMap::AddHeight(const int idx, const float a) { return SetHeight(idx, a, 1); }
 inline float CReadMap::SetHeight(const int idx, const float h, const int add) {
-	return SetHeightValue((*heightMapSyncedPtr)[idx], idx, h, add);
+	// deformations can precede their UpdateHeightMapSynced call by
+	// a few frames, cached samples must not outlive the raw values
+	heightMapSyncedGeneration++;
+
+	const float newHeight = SetHeightValue((*heightMapSyncedPtr)[idx], idx, h, add);
+
+	// same holds for the max-height mips synced traces skip terrain with
+	RaiseMipMaxHeights(idx, newHeight);
+	return newHeight;
 }
 
 inline float CReadMap::AddOriginalHeight(const int idx, const float a) { return SetOriginalHeight(idx, a, 1); }
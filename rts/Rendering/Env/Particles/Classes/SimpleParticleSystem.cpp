@@ -15,6 +15,8 @@
 #include "System/Log/ILog.h"
 #include "System/SpringMath.h"
 
+#include "xsimd/xsimd.hpp"
+
 #include "System/Misc/TracyDefs.h"
 
 CR_BIND_DERIVED(CSimpleParticleSystem, CProjectile, )
@@ -41,25 +43,11 @@ CR_REG_METADATA(CSimpleParticleSystem,
 		CR_MEMBER(sizeGrowth),
 		CR_MEMBER(sizeMod),
 	CR_MEMBER_ENDFLAG(CM_Config),
-	CR_MEMBER(particles),
+	CR_MEMBER(particleData),
+	CR_MEMBER(numLiveParticles),
 	CR_SERIALIZER(Serialize)
 ))
 
-CR_BIND(CSimpleParticleSystem::Particle, )
-
-CR_REG_METADATA_SUB(CSimpleParticleSystem, Particle,
-(
-	CR_MEMBER(pos),
-	CR_MEMBER(speed),
-	CR_MEMBER(life),
-	CR_MEMBER(rotVal),
-	CR_MEMBER(rotVel),
-	CR_MEMBER(decayrate),
-	CR_MEMBER(size),
-	CR_MEMBER(sizeGrowth),
-	CR_MEMBER(sizeMod)
-))
-
 CSimpleParticleSystem::CSimpleParticleSystem()
 	: CProjectile()
 	, emitVector(ZeroVector)
@@ -80,6 +68,7 @@ CSimpleParticleSystem::CSimpleParticleSystem()
 	, sizeGrowth(0.0f)
 	, sizeMod(0.0f)
 	, numParticles(0)
+	, numLiveParticles(0)
 {
 	checkCol = false;
 	useAirLos = true;
@@ -105,12 +94,13 @@ void CSimpleParticleSystem::Draw()
 	float3 ydir;
 	float3 xdir;
 
-	const auto DoParticleDraw = [this](const float3& xdir, const float3& ydir, const float3& zdir, const Particle* p) {
-		const float3 pDrawPos = p->pos + p->speed * globalRendering->timeOffset;
-		const float size = p->size;
+	const auto DoParticleDraw = [this](const float3& xdir, const float3& ydir, const float3& zdir, const float3& pos, const float3& speed, int i) {
+		const float3 pDrawPos = pos + speed * globalRendering->timeOffset;
+		const float size = GetChannel(PC_SIZE)[i];
+		const float rotVal = GetChannel(PC_ROT_VAL)[i];
 
 		unsigned char color[4];
-		colorMap->GetColor(color, p->life);
+		colorMap->GetColor(color, GetChannel(PC_LIFE)[i]);
 
 		std::array<float3, 4> bounds = {
 			-ydir * size - xdir * size,
@@ -119,8 +109,8 @@ void CSimpleParticleSystem::Draw()
 			 ydir * size - xdir * size
 		};
 
-		if (math::fabs(p->rotVal) > 0.01f) {
-			float3::rotate<false>(p->rotVal, zdir, bounds);
+		if (math::fabs(rotVal) > 0.01f) {
+			float3::rotate<false>(rotVal, zdir, bounds);
 		}
 		AddEffectsQuad(
 			{ pDrawPos + bounds[0], texture->xstart, texture->ystart, color },
@@ -132,14 +122,12 @@ void CSimpleParticleSystem::Draw()
 
 	const bool shadowPass = (camera->GetCamType() == CCamera::CAMTYPE_SHADOW);
 	if (directional && !shadowPass) {
-		for (int i = 0; i < numParticles; i++) {
-			const Particle* p = &particles[i];
+		for (int i = 0; i < numLiveParticles; i++) {
+			const float3 pos = GetParticlePos(i);
+			const float3 speed = GetParticleSpeed(i);
 
-			if (p->life >= 1.0f)
-				continue;
-
-			zdir = (p->pos - camera->GetPos()).SafeANormalize();
-			ydir = zdir.cross(p->speed);
+			zdir = (pos - camera->GetPos()).SafeANormalize();
+			ydir = zdir.cross(speed);
 			if likely(ydir.SqLength() > 0.001f) {
 				ydir.SafeANormalize();
 				xdir = ydir.cross(zdir);
@@ -150,44 +138,130 @@ void CSimpleParticleSystem::Draw()
 				ydir = camera->GetUp();
 			}
 
-			DoParticleDraw(xdir, ydir, zdir, p);
+			DoParticleDraw(xdir, ydir, zdir, pos, speed, i);
 		}
 		return;
 	}
 
 	// !directional
-	for (int i = 0; i < numParticles; i++) {
-		const Particle* p = &particles[i];
-
-		if (p->life >= 1.0f)
-			continue;
+	zdir = camera->GetForward();
+	xdir = camera->GetRight();
+	ydir = camera->GetUp();
 
-		zdir = camera->GetForward();
-		xdir = camera->GetRight();
-		ydir = camera->GetUp();
-		
-		DoParticleDraw(xdir, ydir, zdir, p);
+	for (int i = 0; i < numLiveParticles; i++) {
+		DoParticleDraw(xdir, ydir, zdir, GetParticlePos(i), GetParticleSpeed(i), i);
 	}
 }
 
 void CSimpleParticleSystem::Update()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	deleteMe = true;
-
-	for (auto& p: particles) {
-		if (p.life < 1.0f) {
-			p.pos    += p.speed;
-			p.speed  += gravity;
-			p.speed  *= airdrag;
-			p.rotVal += p.rotVel;
-			p.rotVel += rotParams.y; //rot accel
-			p.life   += p.decayrate;
-			p.size    = p.size * sizeMod + sizeGrowth;
-
-			deleteMe = false;
+	using FloatBatch = xsimd::simd_type<float>;
+
+	constexpr int N = FloatBatch::size;
+
+	// keep the system around for one more frame after its last particle
+	// expired, same as when dead particles were skipped individually
+	if ((deleteMe = (numLiveParticles == 0)))
+		return;
+
+	float* posX = GetChannel(PC_POS_X);
+	float* posY = GetChannel(PC_POS_Y);
+	float* posZ = GetChannel(PC_POS_Z);
+	float* speedX = GetChannel(PC_SPEED_X);
+	float* speedY = GetChannel(PC_SPEED_Y);
+	float* speedZ = GetChannel(PC_SPEED_Z);
+	float* rotVal = GetChannel(PC_ROT_VAL);
+	float* rotVel = GetChannel(PC_ROT_VEL);
+	float* life = GetChannel(PC_LIFE);
+	float* decayRate = GetChannel(PC_DECAYRATE);
+	float* size = GetChannel(PC_SIZE);
+
+	const auto IntegrateBatch = [](float* p, float* v, const FloatBatch& a, const FloatBatch& drag) {
+		FloatBatch bp;
+		FloatBatch bv;
+
+		bp.load_unaligned(p);
+		bv.load_unaligned(v);
+
+		(bp + bv).store_unaligned(p);
+		((bv + a) * drag).store_unaligned(v);
+	};
+
+	const FloatBatch gravityX(gravity.x);
+	const FloatBatch gravityY(gravity.y);
+	const FloatBatch gravityZ(gravity.z);
+	const FloatBatch rotAccel(rotParams.y);
+	const FloatBatch bAirDrag(airdrag);
+	const FloatBatch bSizeMod(sizeMod);
+	const FloatBatch bSizeGrowth(sizeGrowth);
+	const FloatBatch one(1.0f);
+
+	int i = 0;
+
+	// same operations (and order) as the scalar tail below
+	for (; (i + N) <= numLiveParticles; i += N) {
+		IntegrateBatch(posX + i, speedX + i, gravityX, bAirDrag);
+		IntegrateBatch(posY + i, speedY + i, gravityY, bAirDrag);
+		IntegrateBatch(posZ + i, speedZ + i, gravityZ, bAirDrag);
+		IntegrateBatch(rotVal + i, rotVel + i, rotAccel, one);
+
+		FloatBatch bl;
+		FloatBatch bd;
+		FloatBatch bs;
+
+		bl.load_unaligned(life + i);
+		bd.load_unaligned(decayRate + i);
+		bs.load_unaligned(size + i);
+
+		(bl + bd).store_unaligned(life + i);
+		(bs * bSizeMod + bSizeGrowth).store_unaligned(size + i);
+	}
+
+	for (; i < numLiveParticles; i++) {
+		posX[i] += speedX[i];
+		posY[i] += speedY[i];
+		posZ[i] += speedZ[i];
+		speedX[i] = (speedX[i] + gravity.x) * airdrag;
+		speedY[i] = (speedY[i] + gravity.y) * airdrag;
+		speedZ[i] = (speedZ[i] + gravity.z) * airdrag;
+		rotVal[i] += rotVel[i];
+		rotVel[i] += rotParams.y; //rot accel
+		life[i] += decayRate[i];
+		size[i] = size[i] * sizeMod + sizeGrowth;
+	}
+
+	CompactParticles();
+}
+
+void CSimpleParticleSystem::CompactParticles()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const float* life = GetChannel(PC_LIFE);
+
+	int numLive = 0;
+
+	while (numLive < numLiveParticles && life[numLive] < 1.0f)
+		numLive++;
+
+	if (numLive == numLiveParticles)
+		return;
+
+	// expired particles are removed in one stable pass so the
+	// survivors keep their spawn (and therefore draw) order
+	for (int i = numLive + 1; i < numLiveParticles; i++) {
+		if (life[i] >= 1.0f)
+			continue;
+
+		for (int c = 0; c < PC_COUNT; c++) {
+			float* channel = GetChannel(static_cast<ParticleChannel>(c));
+			channel[numLive] = channel[i];
 		}
+
+		numLive++;
 	}
+
+	numLiveParticles = numLive;
 }
 
 void CSimpleParticleSystem::Init(const CUnit* owner, const float3& offset)
@@ -209,18 +283,27 @@ void CSimpleParticleSystem::Init(const CUnit* owner, const float3& offset)
 		LOG_L(L_WARNING, "[CSimpleParticleSystem::%s] no texture specified", __func__);
 	}
 
-	particles.resize(numParticles);
-	for (auto& p: particles) {
+	numParticles = std::max(numParticles, 0);
+	numLiveParticles = numParticles;
+	particleData.resize(numParticles * PC_COUNT);
+
+	for (int i = 0; i < numParticles; i++) {
 		float az = guRNG.NextFloat() * math::TWOPI;
 		float ay = (emitRot + (emitRotSpread * guRNG.NextFloat())) * math::DEG_TO_RAD;
 
-		p.pos = offset;
-		p.speed = ((up * emitMul.y) * fastmath::cos(ay) - ((right * emitMul.x) * fastmath::cos(az) - (forward * emitMul.z) * fastmath::sin(az)) * fastmath::sin(ay)) * (particleSpeed + (guRNG.NextFloat() * particleSpeedSpread));
-		p.rotVal = rotParams.z; //initial rotation value
-		p.rotVel = rotParams.x; //initial rotation velocity
-		p.life = 0.0f;
-		p.decayrate = 1.0f / (particleLife + (guRNG.NextFloat() * particleLifeSpread));
-		p.size = particleSize + guRNG.NextFloat()*particleSizeSpread;
+		const float3 speed = ((up * emitMul.y) * fastmath::cos(ay) - ((right * emitMul.x) * fastmath::cos(az) - (forward * emitMul.z) * fastmath::sin(az)) * fastmath::sin(ay)) * (particleSpeed + (guRNG.NextFloat() * particleSpeedSpread));
+
+		GetChannel(PC_POS_X)[i] = offset.x;
+		GetChannel(PC_POS_Y)[i] = offset.y;
+		GetChannel(PC_POS_Z)[i] = offset.z;
+		GetChannel(PC_SPEED_X)[i] = speed.x;
+		GetChannel(PC_SPEED_Y)[i] = speed.y;
+		GetChannel(PC_SPEED_Z)[i] = speed.z;
+		GetChannel(PC_ROT_VAL)[i] = rotParams.z; //initial rotation value
+		GetChannel(PC_ROT_VEL)[i] = rotParams.x; //initial rotation velocity
+		GetChannel(PC_LIFE)[i] = 0.0f;
+		GetChannel(PC_DECAYRATE)[i] = 1.0f / (particleLife + (guRNG.NextFloat() * particleLifeSpread));
+		GetChannel(PC_SIZE)[i] = particleSize + guRNG.NextFloat()*particleSizeSpread;
 	}
 
 	drawRadius = (particleSpeed + particleSpeedSpread) * (particleLife + particleLifeSpread);
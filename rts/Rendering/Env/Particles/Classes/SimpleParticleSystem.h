@@ -13,11 +13,10 @@ class CColorMap;
 class CSimpleParticleSystem : public CProjectile
 {
 	CR_DECLARE_DERIVED(CSimpleParticleSystem)
-	CR_DECLARE_SUB(Particle)
 
 public:
 	CSimpleParticleSystem();
-	virtual ~CSimpleParticleSystem() { particles.clear(); }
+	virtual ~CSimpleParticleSystem() { particleData.clear(); }
 
 	void Serialize(creg::ISerializer* s);
 
@@ -53,25 +52,38 @@ protected:
 
 	int numParticles;
 
-	struct Particle
-	{
-		CR_DECLARE_STRUCT(Particle)
+	// particle state is stored as a structure of arrays, one contiguous
+	// float channel of <numParticles> entries per attribute, so Update
+	// can integrate all live particles with SIMD batches
+	enum ParticleChannel {
+		PC_POS_X     =  0,
+		PC_POS_Y     =  1,
+		PC_POS_Z     =  2,
+		PC_SPEED_X   =  3,
+		PC_SPEED_Y   =  4,
+		PC_SPEED_Z   =  5,
+		PC_ROT_VAL   =  6,
+		PC_ROT_VEL   =  7,
+		PC_LIFE      =  8,
+		PC_DECAYRATE =  9,
+		PC_SIZE      = 10,
+		PC_COUNT     = 11,
+	};
 
-		float3 pos;
-		float3 speed;
+	      float* GetChannel(ParticleChannel c)       { return &particleData[c * numParticles]; }
+	const float* GetChannel(ParticleChannel c) const { return &particleData[c * numParticles]; }
 
-		float rotVal;
-		float rotVel;
+	float3 GetParticlePos(int i) const { return {GetChannel(PC_POS_X)[i], GetChannel(PC_POS_Y)[i], GetChannel(PC_POS_Z)[i]}; }
+	float3 GetParticleSpeed(int i) const { return {GetChannel(PC_SPEED_X)[i], GetChannel(PC_SPEED_Y)[i], GetChannel(PC_SPEED_Z)[i]}; }
 
-		float life;
-		float decayrate;
-		float size;
-		float sizeGrowth;
-		float sizeMod;
-	};
+private:
+	void CompactParticles();
 
 protected:
-	 std::vector<Particle> particles;
+	std::vector<float> particleData;
+
+	// live particles are kept (in spawn order) in [0, numLiveParticles)
+	int numLiveParticles;
 };
 
 /**
@@ -49,7 +49,9 @@ CR_REG_METADATA(LocalModel, (
 
 	CR_MEMBER(boundingVolume),
 	CR_IGNORED(luaMaterialData),
-	CR_MEMBER(needsBoundariesRecalc)
+	CR_MEMBER(needsBoundariesRecalc),
+	CR_IGNORED(pieceBVH),
+	CR_IGNORED(needsPieceBVHRefit)
 ))
 
 
@@ -424,6 +426,17 @@ void LocalModel::UpdateBoundingVolume()
 	needsBoundariesRecalc = false;
 }
 
+const LocalModelPieceBVH& LocalModel::GetPieceBVH() const
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (needsPieceBVHRefit) {
+		pieceBVH.Refit(*this);
+		needsPieceBVHRefit = false;
+	}
+
+	return pieceBVH;
+}
+
 /** ****************************************************************************************************
  * LocalModelPiece
  */
@@ -441,6 +454,7 @@ LocalModelPiece::LocalModelPiece(const S3DModelPiece* piece)
 
 	, original(piece)
 	, parent(nullptr) // set later
+	, localModel(nullptr) // set later
 {
 	assert(piece != nullptr);
 
@@ -457,6 +471,9 @@ void LocalModelPiece::SetDirty() {
 	dirty = true;
 	SetGetCustomDirty(true);
 
+	if (localModel != nullptr)
+		localModel->SetPieceBVHNeedsRefit();
+
 	for (LocalModelPiece* child: children) {
 		if (child->dirty)
 			continue;
@@ -8,6 +8,7 @@
 #include <vector>
 #include <string>
 
+#include "LocalModelPieceBVH.h"
 #include "ModelsMemStorage.h"
 #include "Lua/LuaObjectMaterial.h"
 #include "Rendering/GL/VBO.h"
@@ -615,6 +616,10 @@ struct LocalModel
 
 	void SetBoundariesNeedsRecalc()       { needsBoundariesRecalc = true; }
 	bool GetBoundariesNeedsRecalc() const { return needsBoundariesRecalc; }
+
+	// refitted on demand after any piece became dirty or changed its volume
+	const LocalModelPieceBVH& GetPieceBVH() const;
+	void SetPieceBVHNeedsRefit() { needsPieceBVHRefit = true; }
 private:
 	LocalModelPiece* CreateLocalModelPieces(const S3DModelPiece* mpParent);
 
@@ -632,6 +637,10 @@ private:
 	LuaObjectMaterialData luaMaterialData;
 
 	bool needsBoundariesRecalc = true;
+
+	// model-space piece volume hierarchy for IntersectPieceTree
+	mutable LocalModelPieceBVH pieceBVH;
+	mutable bool needsPieceBVHRefit = true;
 };
 
 #endif /* _3DMODEL_H */
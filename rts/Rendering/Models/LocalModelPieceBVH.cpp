@@ -0,0 +1,158 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "LocalModelPieceBVH.h"
+#include "3DModel.h"
+
+#include <numeric>
+
+#include "System/Misc/TracyDefs.h"
+
+// keeps the traversal stack in LocalModelPieceBVH::Traverse bounded
+static constexpr uint32_t MAX_BVH_DEPTH = 24;
+static constexpr uint32_t MAX_LEAF_PIECES = 2;
+
+
+void LocalModelPieceBVH::CalcPieceBox(const LocalModel& lm, uint32_t pieceIdx, float3& mins, float3& maxs) const
+{
+	const LocalModelPiece* lmp = lm.GetPiece(pieceIdx);
+	const CollisionVolume* vol = lmp->GetCollisionVolume();
+	const CMatrix44f& mat = lmp->GetModelSpaceMatrix();
+
+	// every volume type fits inside the box spanned by its half-scales; add
+	// a small margin so rays grazing a face are still handed to the exact test
+	const float3 hs = vol->GetHScales() + OnesVector;
+	const float3 vo = vol->GetOffsets();
+
+	mins = DEF_MIN_SIZE;
+	maxs = DEF_MAX_SIZE;
+
+	for (int i = 0; i < 8; i++) {
+		const float3 corner = {
+			vo.x + hs.x * ((i & 1)? 1.0f: -1.0f),
+			vo.y + hs.y * ((i & 2)? 1.0f: -1.0f),
+			vo.z + hs.z * ((i & 4)? 1.0f: -1.0f),
+		};
+		const float3 vertex = mat * corner;
+
+		mins = float3::min(mins, vertex);
+		maxs = float3::max(maxs, vertex);
+	}
+}
+
+
+void LocalModelPieceBVH::Build(const LocalModel& lm)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const uint32_t numPieces = lm.pieces.size();
+
+	Clear();
+
+	if (numPieces == 0)
+		return;
+
+	pieceIndices.resize(numPieces);
+	pieceMins.resize(numPieces);
+	pieceMaxs.resize(numPieces);
+
+	std::iota(pieceIndices.begin(), pieceIndices.end(), 0);
+
+	for (uint32_t i = 0; i < numPieces; i++) {
+		CalcPieceBox(lm, i, pieceMins[i], pieceMaxs[i]);
+	}
+
+	nodes.reserve(numPieces * 2);
+	BuildRec(0, numPieces, 0);
+
+	pieceMins.clear();
+	pieceMaxs.clear();
+}
+
+uint32_t LocalModelPieceBVH::BuildRec(uint32_t first, uint32_t count, uint32_t depth)
+{
+	const uint32_t nodeIdx = nodes.size();
+
+	Node& node = nodes.emplace_back();
+	node.mins = DEF_MIN_SIZE;
+	node.maxs = DEF_MAX_SIZE;
+
+	float3 cmins = DEF_MIN_SIZE;
+	float3 cmaxs = DEF_MAX_SIZE;
+
+	for (uint32_t i = first; i < first + count; i++) {
+		const uint32_t pieceIdx = pieceIndices[i];
+		const float3 center = (pieceMins[pieceIdx] + pieceMaxs[pieceIdx]) * 0.5f;
+
+		node.mins = float3::min(node.mins, pieceMins[pieceIdx]);
+		node.maxs = float3::max(node.maxs, pieceMaxs[pieceIdx]);
+
+		cmins = float3::min(cmins, center);
+		cmaxs = float3::max(cmaxs, center);
+	}
+
+	if (count <= MAX_LEAF_PIECES || depth >= MAX_BVH_DEPTH) {
+		node.offset = first;
+		node.count = count;
+		return nodeIdx;
+	}
+
+	// median split along the axis of largest center-spread
+	const float3 spread = cmaxs - cmins;
+	const int axis = (spread.x > spread.y && spread.x > spread.z)? 0: ((spread.y > spread.z)? 1: 2);
+
+	const auto beg = pieceIndices.begin() + first;
+	const auto mid = beg + count / 2;
+	const auto end = beg + count;
+
+	std::nth_element(beg, mid, end, [&](uint32_t a, uint32_t b) {
+		return ((pieceMins[a][axis] + pieceMaxs[a][axis]) < (pieceMins[b][axis] + pieceMaxs[b][axis]));
+	});
+
+	// left child directly follows its parent, right child is linked
+	BuildRec(first, count / 2, depth + 1);
+
+	const uint32_t rgtIdx = BuildRec(first + count / 2, count - count / 2, depth + 1);
+
+	// <node> might have been invalidated by reallocation
+	nodes[nodeIdx].offset = rgtIdx;
+	nodes[nodeIdx].count = 0;
+	return nodeIdx;
+}
+
+
+void LocalModelPieceBVH::Refit(const LocalModel& lm)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (nodes.empty() || pieceIndices.size() != lm.pieces.size()) {
+		Build(lm);
+		return;
+	}
+
+	// children are always stored after their parent, so a reverse sweep
+	// visits both of them before the parent itself
+	for (size_t n = nodes.size(); n-- > 0; ) {
+		Node& node = nodes[n];
+
+		if (node.IsLeaf()) {
+			node.mins = DEF_MIN_SIZE;
+			node.maxs = DEF_MAX_SIZE;
+
+			for (uint32_t i = node.offset, e = node.offset + node.count; i < e; i++) {
+				float3 mins;
+				float3 maxs;
+
+				CalcPieceBox(lm, pieceIndices[i], mins, maxs);
+
+				node.mins = float3::min(node.mins, mins);
+				node.maxs = float3::max(node.maxs, maxs);
+			}
+
+			continue;
+		}
+
+		const Node& lft = nodes[n + 1];
+		const Node& rgt = nodes[node.offset];
+
+		node.mins = float3::min(lft.mins, rgt.mins);
+		node.maxs = float3::max(lft.maxs, rgt.maxs);
+	}
+}
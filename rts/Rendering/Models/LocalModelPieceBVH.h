@@ -0,0 +1,172 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _LOCAL_MODEL_PIECE_BVH_H
+#define _LOCAL_MODEL_PIECE_BVH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "System/float3.h"
+
+struct LocalModel;
+
+/**
+ * Bounding-volume hierarchy over the collision volumes of a LocalModel's
+ * pieces, used by CCollisionHandler::IntersectPieceTree to only test the
+ * pieces a ray can actually hit.
+ *
+ * Boxes are kept in model space (relative to the owner's transform) so
+ * moving the owner does not invalidate them; only piece animation (i.e.
+ * LocalModelPiece::SetDirty) or changed piece volumes require a refit,
+ * which is done lazily on the next query. The tree topology is built once
+ * from the initial pose and only refitted afterwards.
+ */
+class LocalModelPieceBVH
+{
+public:
+	struct Node {
+		float3 mins;
+		float3 maxs;
+
+		// inner nodes: index of the second child (the first one is
+		// always stored directly after its parent), leaves: index of
+		// the first piece in pieceIndices
+		uint32_t offset = 0;
+		// number of pieces for leaves, 0 for inner nodes
+		uint32_t count = 0;
+
+		bool IsLeaf() const { return (count != 0); }
+	};
+
+	void Clear() {
+		nodes.clear();
+		pieceIndices.clear();
+	}
+
+	bool Empty() const { return nodes.empty(); }
+
+	void Build(const LocalModel& lm);
+	void Refit(const LocalModel& lm);
+
+	/**
+	 * Calls visitor(pieceIndex) for every piece whose box is intersected by
+	 * the model-space segment [p0, p1]. The visitor returns the current
+	 * squared distance limit (from p0) beyond which nodes can be culled or
+	 * a negative value to stop the traversal.
+	 */
+	template<typename Visitor>
+	void Traverse(const float3& p0, const float3& p1, Visitor&& visitor) const;
+
+private:
+	static bool IntersectBox(const float3& mins, const float3& maxs, const float3& p0, const float3& dir, const float3& invDir, float& tEnter);
+
+	uint32_t BuildRec(uint32_t first, uint32_t count, uint32_t depth);
+	void CalcPieceBox(const LocalModel& lm, uint32_t pieceIdx, float3& mins, float3& maxs) const;
+
+private:
+	std::vector<Node> nodes;
+	std::vector<uint32_t> pieceIndices;
+
+	// scratch space used only while building
+	std::vector<float3> pieceMins;
+	std::vector<float3> pieceMaxs;
+};
+
+
+inline bool LocalModelPieceBVH::IntersectBox(
+	const float3& mins,
+	const float3& maxs,
+	const float3& p0,
+	const float3& dir,
+	const float3& invDir,
+	float& tEnter
+) {
+	float tmin = 0.0f;
+	float tmax = 1.0f;
+
+	for (int i = 0; i < 3; i++) {
+		if (dir[i] == 0.0f) {
+			if (p0[i] < mins[i] || p0[i] > maxs[i])
+				return false;
+
+			continue;
+		}
+
+		float t0 = (mins[i] - p0[i]) * invDir[i];
+		float t1 = (maxs[i] - p0[i]) * invDir[i];
+
+		if (t0 > t1)
+			std::swap(t0, t1);
+
+		tmin = std::max(tmin, t0);
+		tmax = std::min(tmax, t1);
+
+		if (tmin > tmax)
+			return false;
+	}
+
+	tEnter = tmin;
+	return true;
+}
+
+template<typename Visitor>
+inline void LocalModelPieceBVH::Traverse(const float3& p0, const float3& p1, Visitor&& visitor) const
+{
+	if (nodes.empty())
+		return;
+
+	const float3 dir = p1 - p0;
+	const float3 invDir = {
+		(dir.x != 0.0f)? (1.0f / dir.x): 0.0f,
+		(dir.y != 0.0f)? (1.0f / dir.y): 0.0f,
+		(dir.z != 0.0f)? (1.0f / dir.z): 0.0f,
+	};
+	const float dirLenSq = dir.SqLength();
+
+	// depth is bounded by BuildRec, 64 entries are plenty
+	uint32_t stack[64];
+	uint32_t stackSize = 0;
+
+	float maxDistSq = std::numeric_limits<float>::max();
+	float tEnter = 0.0f;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = nodes[stack[--stackSize]];
+
+		if (!IntersectBox(node.mins, node.maxs, p0, dir, invDir, tEnter))
+			continue;
+		// everything in this node starts beyond the closest hit found so far
+		if ((tEnter * tEnter * dirLenSq) > maxDistSq)
+			continue;
+
+		if (node.IsLeaf()) {
+			for (uint32_t i = node.offset, n = node.offset + node.count; i < n; i++) {
+				if ((maxDistSq = visitor(pieceIndices[i])) < 0.0f)
+					return;
+			}
+
+			continue;
+		}
+
+		const uint32_t lftIdx = (&node - &nodes[0]) + 1;
+		const uint32_t rgtIdx = node.offset;
+
+		// visit the child nearer to p0 first so culling kicks in sooner
+		const float3 lftMid = (nodes[lftIdx].mins + nodes[lftIdx].maxs) * 0.5f;
+		const float3 rgtMid = (nodes[rgtIdx].mins + nodes[rgtIdx].maxs) * 0.5f;
+
+		if (lftMid.SqDistance(p0) < rgtMid.SqDistance(p0)) {
+			stack[stackSize++] = rgtIdx;
+			stack[stackSize++] = lftIdx;
+		} else {
+			stack[stackSize++] = lftIdx;
+			stack[stackSize++] = rgtIdx;
+		}
+	}
+}
+
+#endif
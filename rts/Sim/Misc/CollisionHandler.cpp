@@ -267,34 +267,43 @@ bool CCollisionHandler::IntersectPiecesHelper(
 	CollisionQuery* cq
 ) {
 	RECOIL_DETAILED_TRACY_ZONE;
+	const LocalModel& lm = o->localModel;
+
 	CMatrix44f volMat;
 
 	float minDistSq = std::numeric_limits<float>::max();
 	float curDistSq = minDistSq;
 
-	for (unsigned int n = 0; n < o->localModel.pieces.size(); n++) {
-		const LocalModelPiece* lmp = o->localModel.GetPiece(n);
+	unsigned int minPieceIdx = -1u;
+
+	// returns true iff the caller only wants to know a collision exists and one was found
+	const auto IntersectPiece = [&](unsigned int n) {
+		const LocalModelPiece* lmp = lm.GetPiece(n);
 		const CollisionVolume* lmpVol = lmp->GetCollisionVolume();
 
 		if (!lmp->GetScriptVisible() || lmpVol->IgnoreHits())
-			continue;
+			return false;
 
 		volMat = m * lmp->GetModelSpaceMatrix();
 		volMat.Translate(lmpVol->GetOffsets());
 
 		CollisionQuery cqn;
 		if (!CCollisionHandler::Intersect(lmpVol, volMat, p0, p1, &cqn))
-			continue;
+			return false;
 
 		// skip if neither an ingress nor an egress hit
 		if (!cqn.AnyHit())
-			continue;
+			return false;
+
+		// save the closest intersection (others are not needed); on ties
+		// prefer the lowest piece index regardless of the visiting order
+		curDistSq = (cqn.GetHitPos()).SqDistance(p0);
 
-		// save the closest intersection (others are not needed)
-		if ((curDistSq = (cqn.GetHitPos()).SqDistance(p0)) >= minDistSq)
-			continue;
+		if (curDistSq > minDistSq || (curDistSq == minDistSq && n > minPieceIdx))
+			return false;
 
 		minDistSq = curDistSq;
+		minPieceIdx = n;
 
 		// return early if caller only wants to know a collision exists
 		if (cq == nullptr)
@@ -302,6 +311,30 @@ bool CCollisionHandler::IntersectPiecesHelper(
 
 		*cq = cqn;
 		cq->SetHitPiece(lmp);
+		return false;
+	};
+
+	if (lm.pieces.size() <= MIN_PIECE_BVH_SIZE) {
+		for (unsigned int n = 0; n < lm.pieces.size(); n++) {
+			if (IntersectPiece(n))
+				return true;
+		}
+	} else {
+		// the piece hierarchy lives in model space; object matrices
+		// are orthonormal so distances are the same in either space
+		const CMatrix44f invMat = m.InvertAffine();
+
+		bool anyHit = false;
+
+		lm.GetPieceBVH().Traverse(invMat * p0, invMat * p1, [&](unsigned int n) {
+			if ((anyHit = IntersectPiece(n)))
+				return -1.0f;
+
+			return minDistSq;
+		});
+
+		if (anyHit)
+			return true;
 	}
 
 	// true iff at least one piece was intersected
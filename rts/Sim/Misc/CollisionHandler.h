@@ -168,6 +168,9 @@ class CCollisionHandler {
 		static bool IntersectBox(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
 
 	private:
+		// models with at most this many pieces are tested linearly instead of through their BVH
+		static constexpr unsigned int MIN_PIECE_BVH_SIZE = 4;
+
 		static unsigned int numDiscTests; // number of discrete hit-tests executed
 		static unsigned int numContTests; // number of continuous hit-tests executed (inc. unsynced)
 };
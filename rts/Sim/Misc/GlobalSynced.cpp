@@ -39,6 +39,7 @@ CR_REG_METADATA(CGlobalSynced, (
 	CR_MEMBER(frameNum),
 	CR_MEMBER(tempNum),
 	CR_MEMBER(mtTempNum),
+	CR_MEMBER(rulesParamsGen),
 	CR_MEMBER(godMode),
 
 	CR_MEMBER(speedFactor),
@@ -65,6 +66,8 @@ void CGlobalSynced::ResetState() {
 
 	std::fill(std::begin(mtTempNum), std::end(mtTempNum), 1);
 
+	rulesParamsGen = 0;
+
 #ifdef SYNCCHECK
 	// reset checksum
 	CSyncChecker::NewFrame();
@@ -3,6 +3,8 @@
 #ifndef _GLOBAL_SYNCED_H
 #define _GLOBAL_SYNCED_H
 
+#include <cstdint>
+
 #include "System/creg/creg_cond.h"
 #include "System/GlobalRNG.h"
 #include "System/Threading/ThreadPool.h"
@@ -45,6 +47,9 @@ public:
 	int GetMtTempNum() { return mtTempNum[ThreadPool::GetThreadNum()]++; }
 	int GetMtTempNum(int tid) { return mtTempNum[tid]++; }
 
+	uint64_t GetRulesParamsGen() const { return rulesParamsGen; }
+	uint64_t NextRulesParamsGen() { return ++rulesParamsGen; }
+
 	// remains true until first SimFrame call
 	bool PreSimFrame() const { return (frameNum == -1); }
 
@@ -58,6 +63,13 @@ private:
 	int tempNum = 1;
 	std::array<int, ThreadPool::MAX_THREADS> mtTempNum = {};
 
+	/**
+	* @brief rules params generation
+	*
+	* Advanced on every LuaRulesParams change, shared by all param sets
+	*/
+	uint64_t rulesParamsGen = 0;
+
 public:
 	/**
 	* @brief frame number
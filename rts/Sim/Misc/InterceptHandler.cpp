@@ -6,6 +6,7 @@
 #include "InterceptHandler.h"
 
 #include "Map/Ground.h"
+#include "Map/ReadMap.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Weapons/Weapon.h"
@@ -23,17 +24,38 @@
 CR_BIND_DERIVED(CInterceptHandler, CObject, )
 CR_REG_METADATA(CInterceptHandler, (
 	CR_MEMBER(interceptors),
-	CR_MEMBER(interceptables)
+	CR_MEMBER(interceptables),
+
+	CR_IGNORED(gridCellOffsets),
+	CR_IGNORED(gridCellProjectiles),
+	CR_IGNORED(gridEntries),
+	CR_IGNORED(candidates),
+	CR_IGNORED(candidateStamps),
+	CR_IGNORED(numGridCellsX),
+	CR_IGNORED(numGridCellsZ),
+	CR_IGNORED(candidateStamp),
+	CR_IGNORED(maxCoverageRange)
 ))
 
 CInterceptHandler interceptHandler;
 
+static constexpr int INTERCEPT_GRID_CELL_SIZE = 256;
+
+// covers the point one step behind a projectile that the range tests
+// can pick when no ground impact is found, plus float slack
+static constexpr float COVERAGE_PADDING = SQUARE_SIZE * 1.0f;
+static constexpr float GROUND_HIT_PADDING = SQUARE_SIZE * 2.0f;
+
 
 
 void CInterceptHandler::Update(bool forced) {
 	RECOIL_DETAILED_TRACY_ZONE;
 	if (((gs->frameNum % UNIT_SLOWUPDATE_RATE) != 0) && !forced)
 		return;
+	if (interceptors.empty() || interceptables.empty())
+		return;
+
+	BuildCandidateGrid();
 
 	for (CWeapon* w: interceptors) {
 		const WeaponDef* wDef = w->weaponDef;
@@ -41,7 +63,13 @@ void CInterceptHandler::Update(bool forced) {
 
 		assert(wDef->interceptor || wDef->isShield);
 
-		for (CWeaponProjectile* p: interceptables) {
+		// only projectiles whose path can come within coverage range,
+		// visited in the same (insertion) order as the full list
+		GetCandidates(w);
+
+		for (const int projIdx: candidates) {
+			CWeaponProjectile* p = interceptables[projIdx];
+
 			if (!p->CanBeInterceptedBy(wDef))
 				continue;
 			if (w->HasIncomingProjectile(p->id))
@@ -119,6 +147,205 @@ void CInterceptHandler::Update(bool forced) {
 
 
 
+void CInterceptHandler::BuildCandidateGrid()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	numGridCellsX = (mapDims.mapx * SQUARE_SIZE + INTERCEPT_GRID_CELL_SIZE - 1) / INTERCEPT_GRID_CELL_SIZE;
+	numGridCellsZ = (mapDims.mapy * SQUARE_SIZE + INTERCEPT_GRID_CELL_SIZE - 1) / INTERCEPT_GRID_CELL_SIZE;
+
+	gridEntries.clear();
+	gridCellOffsets.clear();
+	gridCellOffsets.resize(numGridCellsX * numGridCellsZ + 1, 0);
+
+	float aimMinY = std::numeric_limits<float>::max();
+	float aimMaxY = std::numeric_limits<float>::lowest();
+
+	maxCoverageRange = 0.0f;
+
+	for (const CWeapon* w: interceptors) {
+		// out-of-map interceptors test every interceptable, see GetCandidates
+		if (!w->aimFromPos.IsInBounds())
+			continue;
+
+		maxCoverageRange = std::max(maxCoverageRange, w->weaponDef->coverageRange);
+		aimMinY = std::min(aimMinY, w->aimFromPos.y);
+		aimMaxY = std::max(aimMaxY, w->aimFromPos.y);
+	}
+
+	maxCoverageRange += COVERAGE_PADDING;
+
+	if (aimMinY > aimMaxY)
+		return;
+
+	const float3 mapCorners[] = {
+		{                               0.0f, 0.0f,                                0.0f},
+		{float3::maxxpos + float3::cmp_eps(), 0.0f,                                0.0f},
+		{                               0.0f, 0.0f, float3::maxzpos + float3::cmp_eps()},
+		{float3::maxxpos + float3::cmp_eps(), 0.0f, float3::maxzpos + float3::cmp_eps()},
+	};
+
+	for (int projIdx = 0, numProjs = interceptables.size(); projIdx < numProjs; projIdx++) {
+		const CWeaponProjectile* p = interceptables[projIdx];
+
+		// Update tests the path up to the first ground hit within the distance
+		// between <p> and the interceptor; bound that distance by the furthest
+		// map corner plus the largest height difference to any aim position
+		float maxDist2D = 0.0f;
+
+		for (const float3& c: mapCorners) {
+			maxDist2D = std::max(maxDist2D, c.distance2D(p->pos));
+		}
+
+		const float maxDistY = std::max(math::fabs(p->pos.y - aimMinY), math::fabs(p->pos.y - aimMaxY));
+		const float groundDist = CGround::LineGroundCol(p->pos, p->pos + p->dir * (maxDist2D + maxDistY + 1.0f));
+		const float pathDist = (groundDist >= 0.0f)? (groundDist + GROUND_HIT_PADDING): 0.0f;
+
+		const float3  pathBeg = p->pos - p->dir;
+		const float3  pathEnd = p->pos + p->dir * pathDist;
+		const float3& pTargetPos = p->GetTargetPos();
+
+		AddCandidateCells(pathBeg.x, pathBeg.z, pathEnd.x, pathEnd.z, projIdx);
+		AddCandidateCells(pTargetPos.x, pTargetPos.z, pTargetPos.x, pTargetPos.z, projIdx);
+	}
+
+	// counting-sort the entries by cell, keeping them in projectile order within each
+	for (const int2& e: gridEntries) {
+		gridCellOffsets[e.x + 1]++;
+	}
+	for (size_t i = 1; i < gridCellOffsets.size(); i++) {
+		gridCellOffsets[i] += gridCellOffsets[i - 1];
+	}
+
+	gridCellProjectiles.resize(gridEntries.size());
+
+	for (const int2& e: gridEntries) {
+		gridCellProjectiles[gridCellOffsets[e.x]++] = e.y;
+	}
+	for (size_t i = gridCellOffsets.size() - 1; i > 0; i--) {
+		gridCellOffsets[i] = gridCellOffsets[i - 1];
+	}
+
+	gridCellOffsets[0] = 0;
+}
+
+void CInterceptHandler::AddCandidateCells(float x0, float z0, float x1, float z1, int projIdx)
+{
+	// clip the segment against the map grown by the largest coverage range,
+	// nothing outside of that can be close enough to an in-map interceptor
+	const float rect[4] = {
+		-maxCoverageRange, float3::maxxpos + maxCoverageRange,
+		-maxCoverageRange, float3::maxzpos + maxCoverageRange,
+	};
+	const float dx = x1 - x0;
+	const float dz = z1 - z0;
+
+	float tmin = 0.0f;
+	float tmax = 1.0f;
+
+	const auto ClipAxis = [&](float p, float d, float lo, float hi) {
+		if (d == 0.0f)
+			return (p >= lo && p <= hi);
+
+		float ta = (lo - p) / d;
+		float tb = (hi - p) / d;
+
+		if (ta > tb)
+			std::swap(ta, tb);
+
+		tmin = std::max(tmin, ta);
+		tmax = std::min(tmax, tb);
+
+		return (tmin <= tmax);
+	};
+
+	if (!ClipAxis(x0, dx, rect[0], rect[1]) || !ClipAxis(z0, dz, rect[2], rect[3]))
+		return;
+
+	const float cx0 = x0 + dx * tmin, cz0 = z0 + dz * tmin;
+	const float cx1 = x0 + dx * tmax, cz1 = z0 + dz * tmax;
+
+	const float minZ = std::min(cz0, cz1);
+	const float maxZ = std::max(cz0, cz1);
+
+	const int minRow = int(math::floor(minZ / INTERCEPT_GRID_CELL_SIZE));
+	const int maxRow = int(math::floor(maxZ / INTERCEPT_GRID_CELL_SIZE));
+
+	// rasterize row by row; rows and columns outside the map collapse onto
+	// the border cells, which is where GetCandidates' clamped lookups land
+	for (int row = minRow; row <= maxRow; row++) {
+		const float rowMinZ = std::max(minZ, row * INTERCEPT_GRID_CELL_SIZE * 1.0f);
+		const float rowMaxZ = std::min(maxZ, (row + 1) * INTERCEPT_GRID_CELL_SIZE * 1.0f);
+
+		float rowMinX = std::min(cx0, cx1);
+		float rowMaxX = std::max(cx0, cx1);
+
+		if (cz1 != cz0) {
+			const float xa = cx0 + (cx1 - cx0) * ((rowMinZ - cz0) / (cz1 - cz0));
+			const float xb = cx0 + (cx1 - cx0) * ((rowMaxZ - cz0) / (cz1 - cz0));
+
+			rowMinX = std::max(rowMinX, std::min(xa, xb));
+			rowMaxX = std::min(rowMaxX, std::max(xa, xb));
+		}
+
+		const int gz = std::clamp(row, 0, numGridCellsZ - 1);
+		const int gx0 = std::clamp(int(math::floor((rowMinX - 1.0f) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsX - 1);
+		const int gx1 = std::clamp(int(math::floor((rowMaxX + 1.0f) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsX - 1);
+
+		for (int gx = gx0; gx <= gx1; gx++) {
+			gridEntries.emplace_back(gz * numGridCellsX + gx, projIdx);
+		}
+	}
+}
+
+void CInterceptHandler::GetCandidates(const CWeapon* w)
+{
+	candidates.clear();
+
+	if (!w->aimFromPos.IsInBounds()) {
+		for (int projIdx = 0, numProjs = interceptables.size(); projIdx < numProjs; projIdx++) {
+			candidates.push_back(projIdx);
+		}
+
+		return;
+	}
+
+	if (candidateStamps.size() < interceptables.size())
+		candidateStamps.resize(interceptables.size(), candidateStamp);
+
+	if ((++candidateStamp) == std::numeric_limits<int>::max()) {
+		std::fill(candidateStamps.begin(), candidateStamps.end(), 0);
+		candidateStamp = 1;
+	}
+
+	const float range = w->weaponDef->coverageRange + COVERAGE_PADDING;
+	const float3& pos = w->aimFromPos;
+
+	const int gx0 = std::clamp(int(math::floor((pos.x - range) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsX - 1);
+	const int gx1 = std::clamp(int(math::floor((pos.x + range) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsX - 1);
+	const int gz0 = std::clamp(int(math::floor((pos.z - range) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsZ - 1);
+	const int gz1 = std::clamp(int(math::floor((pos.z + range) / INTERCEPT_GRID_CELL_SIZE)), 0, numGridCellsZ - 1);
+
+	for (int gz = gz0; gz <= gz1; gz++) {
+		for (int gx = gx0; gx <= gx1; gx++) {
+			const int cellIdx = gz * numGridCellsX + gx;
+
+			for (int i = gridCellOffsets[cellIdx], n = gridCellOffsets[cellIdx + 1]; i < n; i++) {
+				const int projIdx = gridCellProjectiles[i];
+
+				if (candidateStamps[projIdx] == candidateStamp)
+					continue;
+
+				candidateStamps[projIdx] = candidateStamp;
+				candidates.push_back(projIdx);
+			}
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+}
+
+
+
 void CInterceptHandler::AddInterceptorWeapon(CWeapon* weapon)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
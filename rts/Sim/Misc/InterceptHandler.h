@@ -4,8 +4,11 @@
 #define INTERCEPT_HANDLER_H
 
 #include <deque>
+#include <vector>
+
 #include "System/Misc/NonCopyable.h"
 #include "System/Object.h"
+#include "System/type2.h"
 
 class CWeapon;
 class CWeaponProjectile;
@@ -26,9 +29,32 @@ public:
 
 	void DependentDied(CObject* o);
 
+private:
+	void BuildCandidateGrid();
+	void GetCandidates(const CWeapon* w);
+
+	void AddCandidateCells(float x0, float z0, float x1, float z1, int projIdx);
+
 private:
 	std::deque<CWeapon*> interceptors;
 	std::deque<CWeaponProjectile*> interceptables;
+
+	// coarse 2D grid over the map, every cell lists the interceptables
+	// (by index) whose path up to its first ground hit or whose target
+	// position falls into it; rebuilt by each Update
+	std::vector<int> gridCellOffsets;
+	std::vector<int> gridCellProjectiles;
+	std::vector<int2> gridEntries;
+
+	std::vector<int> candidates;
+	std::vector<int> candidateStamps;
+
+	int numGridCellsX = 0;
+	int numGridCellsZ = 0;
+	int candidateStamp = 0;
+
+	// largest coverage radius of any interceptor, plus padding
+	float maxCoverageRange = 0.0f;
 };
 
 extern CInterceptHandler interceptHandler;
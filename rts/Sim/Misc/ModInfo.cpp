@@ -42,6 +42,7 @@ void CModInfo::ResetState()
 		maxCollisionPushMultiplier = std::numeric_limits<float>::infinity();
 		unitQuadPositionUpdateRate = 3;
 		groundUnitCollisionAvoidanceUpdateRate = 3;
+		groundUnitSeparationFieldCellSize = 0;
 	}
 	{
 		constructionDecay      = true;
@@ -51,6 +52,7 @@ void CModInfo::ResetState()
 	}
 	{
 		debrisDamage = 50.0f;
+		batchHitScanTraces = false;
 	}
 	{
 		multiReclaim                   = 0;
@@ -207,6 +209,7 @@ void CModInfo::Init(const std::string& modFileName)
 		maxCollisionPushMultiplier = movementTbl.GetFloat("maxCollisionPushMultiplier", maxCollisionPushMultiplier);
 		unitQuadPositionUpdateRate = movementTbl.GetInt("unitQuadPositionUpdateRate",  unitQuadPositionUpdateRate);
 		groundUnitCollisionAvoidanceUpdateRate = movementTbl.GetInt("groundUnitCollisionAvoidanceUpdateRate",  groundUnitCollisionAvoidanceUpdateRate);
+		groundUnitSeparationFieldCellSize = movementTbl.GetInt("groundUnitSeparationFieldCellSize",  groundUnitSeparationFieldCellSize);
 
 	}
 
@@ -224,6 +227,7 @@ void CModInfo::Init(const std::string& modFileName)
 		const LuaTable& damageTbl = root.SubTable("damage");
 
 		debrisDamage = damageTbl.GetFloat("debris", debrisDamage);
+		batchHitScanTraces = damageTbl.GetBool("batchHitScanTraces", batchHitScanTraces);
 	}
 	{
 		// reclaim
@@ -354,6 +358,7 @@ void CModInfo::Init(const std::string& modFileName)
 	// Soft constraints                                                                               min     max
 	constructionDecaySpeed                   = std::max  (constructionDecaySpeed                  ,    0.01f      );
 	groundUnitCollisionAvoidanceUpdateRate   = std::clamp(groundUnitCollisionAvoidanceUpdateRate  ,    1    ,   15);
+	groundUnitSeparationFieldCellSize        = std::clamp(groundUnitSeparationFieldCellSize       ,    0    , 1024);
 	pfRawMoveSpeedThreshold                  = std::max  (pfRawMoveSpeedThreshold                 ,    0.0f       );
 	pfRepathDelayInFrames                    = std::clamp(pfRepathDelayInFrames                   ,    0    ,  300);
 	pfRepathMaxRateInFrames                  = std::clamp(pfRepathMaxRateInFrames                 ,    0    , 3600);
@@ -62,6 +62,11 @@ public:
 	// a lower number will increase CPU load, but improve reaction time of collision avoidance
 	int groundUnitCollisionAvoidanceUpdateRate;
 
+	// size in elmos of the cells of the per-frame unit density field that ground/sea units steer
+	// around when avoiding moving units (default: 0, disabled; every unit queries its neighbours)
+	// a non-zero value keeps avoidance cost per unit flat in large crowds at the price of accuracy
+	int groundUnitSeparationFieldCellSize;
+
 	// Build behaviour
 	/// Should constructions without builders decay?
 	bool constructionDecay;
@@ -75,6 +80,9 @@ public:
 	// Damage behaviour
 	/// unit pieces flying off (usually on death)
 	float debrisDamage;
+	/// trace all beam and lightning shots of a frame in one parallel batch after the weapon updates
+	/// (default false; every shot is traced and applied as soon as it is fired)
+	bool batchHitScanTraces;
 
 	/* FIXME: ideally things like debris / forest fire AoE would also
 	 * be configurable, but it would be best to implement it as a fake
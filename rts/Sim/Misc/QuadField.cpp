@@ -43,6 +43,9 @@ CR_REG_METADATA_SUB(CQuadField, Quad, (
 	CR_MEMBER(features),
 	CR_MEMBER(projectiles),
 	CR_MEMBER(repulsers),
+	CR_IGNORED(teamUnitBounds),
+	CR_IGNORED(unitBounds),
+	CR_IGNORED(featureBounds),
 
 	CR_POSTLOAD(PostLoad)
 ))
@@ -422,6 +425,45 @@ void CQuadField::GetQuadsOnWideRay(QuadFieldQuery& qfq, const float3& start, con
 
 
 #ifndef UNIT_TEST
+void CQuadField::ObjectBounds::AddObject(const CSolidObject* obj)
+{
+	const CollisionVolume* cv = &obj->collisionVolume;
+
+	if (cv->DefaultToPieceTree()) {
+		noCull = true;
+		return;
+	}
+
+	const float3 cvPos = cv->GetWorldSpacePos(obj);
+	const float cvRad = cv->GetBoundingRadius() + obj->speed.w + 1.0f;
+
+	mins = float3::min(mins, cvPos - cvRad);
+	maxs = float3::max(maxs, cvPos + cvRad);
+}
+
+void CQuadField::UpdateObjectBounds()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	for (Quad& quad: baseQuads) {
+		for (ObjectBounds& bounds: quad.teamUnitBounds) {
+			bounds.Reset();
+		}
+
+		quad.unitBounds.Reset();
+		quad.featureBounds.Reset();
+
+		for (const CUnit* unit: quad.units) {
+			quad.unitBounds.AddObject(unit);
+			quad.teamUnitBounds[unit->allyteam].AddObject(unit);
+		}
+
+		for (const CFeature* feature: quad.features) {
+			quad.featureBounds.AddObject(feature);
+		}
+	}
+}
+
+
 bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -440,6 +482,8 @@ bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].units, unit, false);
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit, false);
+	baseQuads[wposQuadIdx].unitBounds.AddObject(unit);
+	baseQuads[wposQuadIdx].teamUnitBounds[unit->allyteam].AddObject(unit);
 	return true;
 }
 
@@ -484,6 +528,12 @@ void CQuadField::MovedUnit(CUnit* unit)
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, unit->pos, unit->radius);
 
+	// widen even if the quads are unchanged, the unit may have been teleported within them
+	for (const int qi: *qfQuery.quads) {
+		baseQuads[qi].unitBounds.AddObject(unit);
+		baseQuads[qi].teamUnitBounds[unit->allyteam].AddObject(unit);
+	}
+
 	// compare if the quads have changed, if not stop here
 	if (qfQuery.quads->size() == unit->quads.size()) {
 		if (std::equal(qfQuery.quads->begin(), qfQuery.quads->end(), unit->quads.begin()))
@@ -577,6 +627,7 @@ void CQuadField::AddFeature(CFeature* feature)
 
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
+		baseQuads[qi].featureBounds.AddObject(feature);
 	}
 }
 
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <vector>
 
 #include "System/Misc/NonCopyable.h"
@@ -169,6 +170,9 @@ public:
 	void MovedRepulser(CPlasmaRepulser* repulser);
 	void RemoveRepulser(CPlasmaRepulser* repulser);
 
+	/// rebuilds every quad's ObjectBounds, once per sim frame
+	void UpdateObjectBounds();
+
 	// Note: ensure ReleaseVector is called in the same thread as original quad field query generated.
 
 	void ReleaseVector(std::vector<CUnit*>* v       , int onThread = 0) { tempUnits[onThread].ReleaseVector(v); }
@@ -177,6 +181,33 @@ public:
 	void ReleaseVector(std::vector<CSolidObject*>* v, int onThread = 0) { tempSolids[onThread].ReleaseVector(v); }
 	void ReleaseVector(std::vector<int>* v          , int onThread = 0) { tempQuads[onThread].ReleaseVector(v); }
 
+	/**
+	 * Conservative bounds of the collision volumes of the objects in one
+	 * quad list, used by TraceRay::Test*Cone to skip quads a cone can not
+	 * reach. Rebuilt by UpdateObjectBounds once per sim frame (after units
+	 * have moved, before their weapons update) and only ever widened in
+	 * between, by MovedUnit, InsertUnitIf and AddFeature; each object also
+	 * contributes its per-frame speed so the bounds hold until the next
+	 * rebuild. Default-constructed (unbuilt) bounds never cull.
+	 */
+	struct ObjectBounds {
+	public:
+		void Reset() {
+			mins = float3( std::numeric_limits<float>::max());
+			maxs = float3(-std::numeric_limits<float>::max());
+			noCull = false;
+		}
+
+		void AddObject(const CSolidObject* obj);
+
+	public:
+		float3 mins;
+		float3 maxs;
+
+		// set for piece-tree volumes, which the object's own volume does not bound
+		bool noCull = true;
+	};
+
 	struct Quad {
 	public:
 		CR_DECLARE_STRUCT(Quad)
@@ -192,11 +223,17 @@ public:
 			features = std::move(q.features);
 			projectiles = std::move(q.projectiles);
 			repulsers = std::move(q.repulsers);
+			teamUnitBounds = std::move(q.teamUnitBounds);
+			unitBounds = q.unitBounds;
+			featureBounds = q.featureBounds;
 			return *this;
 		}
 
 		void PostLoad();
-		void Resize(int numAllyTeams) { teamUnits.resize(numAllyTeams); }
+		void Resize(int numAllyTeams) {
+			teamUnits.resize(numAllyTeams);
+			teamUnitBounds.resize(numAllyTeams);
+		}
 		void Clear() {
 			units.clear();
 			// reuse inner vectors when reloading
@@ -207,6 +244,10 @@ public:
 			features.clear();
 			projectiles.clear();
 			repulsers.clear();
+
+			std::fill(teamUnitBounds.begin(), teamUnitBounds.end(), ObjectBounds{});
+			unitBounds = {};
+			featureBounds = {};
 		}
 
 	public:
@@ -215,6 +256,10 @@ public:
 		std::vector<CFeature*> features;
 		std::vector<CProjectile*> projectiles;
 		std::vector<CPlasmaRepulser*> repulsers;
+
+		std::vector<ObjectBounds> teamUnitBounds;
+		ObjectBounds unitBounds;
+		ObjectBounds featureBounds;
 	};
 
 	const Quad& GetQuad(unsigned i) const {
@@ -4,6 +4,7 @@
 #define MOVE_TYPE_COMPONENTS_H__
 
 #include "MoveTypesEvents.h"
+#include "Sim/MoveTypes/Utils/SeparationField.h"
 #include "System/Ecs/Components/BaseComponents.h"
 #include <System/Threading/ThreadPool.h>
 
@@ -43,6 +44,10 @@ void serializeComponents(Archive &archive, Snapshot &snapshot) {
 struct GroundMoveSystemComponent {
 	static constexpr std::size_t page_size = 1;
     static constexpr std::size_t INITIAL_TRAP_UNIT_LIST_ALLOC_SIZE = 64;
+
+    // rebuilt at the start of every frame, see GroundMoveSystem::Update
+    SeparationField separationField;
+    std::vector<CUnit*> separationFieldUnits;
 };
 
 struct YardmapTrapCheckSystemComponent {
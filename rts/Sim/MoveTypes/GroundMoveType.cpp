@@ -100,6 +100,10 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_GMT)
 CR_BIND_DERIVED(CGroundMoveType, AMoveType, (nullptr))
 CR_REG_METADATA(CGroundMoveType, (
 	CR_IGNORED(pathController),
+	CR_IGNORED(groundSampleX),
+	CR_IGNORED(groundSampleZ),
+	CR_IGNORED(groundSampleHeight),
+	CR_IGNORED(groundSampleGeneration),
 
 	CR_MEMBER(currWayPoint),
 	CR_MEMBER(nextWayPoint),
@@ -1854,102 +1858,110 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 
 	MoveTypes::CheckCollisionQuery avoiderInfo(avoider);
 
-	QuadFieldQuery qfQuery;
-	qfQuery.threadOwner = ThreadPool::GetThreadNum();
-	quadField.GetSolidsExact(qfQuery, avoider->pos, avoidanceRadius, 0xFFFFFFFF, CSolidObject::CSTATE_BIT_SOLIDOBJECTS);
+	const SeparationField& separationField = Sim::systemGlobals.GetSystemComponent<GroundMoveSystemComponent>().separationField;
 
-	for (const CSolidObject* avoidee: *qfQuery.solids) {
-		const MoveDef* avoideeMD = avoidee->moveDef;
-		const UnitDef* avoideeUD = dynamic_cast<const UnitDef*>(avoidee->GetDef());
+	if (separationField.IsEnabled()) {
+		// crowd case: steer around the per-cell aggregates instead of every neighbour
+		avoidanceVec = GetSeparationFieldAvoidanceVec(separationField, avoidanceRadius, avoiderRadius, MAX_AVOIDEE_COSINE);
+		avoidingUnits = (avoidanceVec != ZeroVector);
+	} else {
+		QuadFieldQuery qfQuery;
+		qfQuery.threadOwner = ThreadPool::GetThreadNum();
+		quadField.GetSolidsExact(qfQuery, avoider->pos, avoidanceRadius, 0xFFFFFFFF, CSolidObject::CSTATE_BIT_SOLIDOBJECTS);
 
-		// cases in which there is no need to avoid this obstacle
-		if (avoidee == owner)
-			continue;
-		// do not avoid statics (it interferes too much with PFS)
-		if (avoideeMD == nullptr)
-			continue;
-		// ignore aircraft (or flying ground units)
-		if (avoidee->IsInAir() || avoidee->IsFlying())
-			continue;
-		if (CMoveMath::IsNonBlocking(avoidee, &avoiderInfo))
-			continue;
-		if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
-			continue;
+		for (const CSolidObject* avoidee: *qfQuery.solids) {
+			const MoveDef* avoideeMD = avoidee->moveDef;
+			const UnitDef* avoideeUD = dynamic_cast<const UnitDef*>(avoidee->GetDef());
 
-		const bool avoideeMobile  = (avoideeMD != nullptr);
-		const bool avoideeMovable = (avoideeUD != nullptr && !static_cast<const CUnit*>(avoidee)->moveType->IsPushResistant());
-
-		const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoidee->pos + avoidee->speed);
-
-		// use the avoidee's MoveDef footprint as radius if it is mobile
-		// use the avoidee's Unit (not UnitDef) footprint as radius otherwise
-		const float avoideeRadius = avoideeMobile?
-			avoideeMD->CalcFootPrintMinExteriorRadius():
-			avoidee->CalcFootPrintMinExteriorRadius();
-		const float avoidanceRadiusSum = avoiderRadius + avoideeRadius;
-		const float avoidanceMassSum = avoider->mass + avoidee->mass;
-		const float avoideeMassScale = avoideeMobile? (avoidee->mass / avoidanceMassSum): 1.0f;
-		const float avoideeDistSq = avoideeVector.SqLength();
-		const float avoideeDist   = math::sqrt(avoideeDistSq) + 0.01f;
-
-		// do not bother steering around idling MOBILE objects
-		// (since collision handling will just push them aside)
-		if (avoideeMobile && avoideeMovable) {
-			if (!avoiderMD->avoidMobilesOnPath || (!avoidee->IsMoving() && avoidee->allyteam == avoider->allyteam))
+			// cases in which there is no need to avoid this obstacle
+			if (avoidee == owner)
+				continue;
+			// do not avoid statics (it interferes too much with PFS)
+			if (avoideeMD == nullptr)
+				continue;
+			// ignore aircraft (or flying ground units)
+			if (avoidee->IsInAir() || avoidee->IsFlying())
+				continue;
+			if (CMoveMath::IsNonBlocking(avoidee, &avoiderInfo))
+				continue;
+			if (!CMoveMath::CrushResistant(*avoiderMD, avoidee))
 				continue;
-		}
 
-		// ignore objects that are more than this many degrees off-center from us
-		// NOTE:
-		//   if MAX_AVOIDEE_COSINE is too small, then this condition can be true
-		//   one frame and false the next (after avoider has turned) causing the
-		//   avoidance vector to oscillate --> units with turnInPlace = true will
-		//   slow to a crawl as a result
-		if (avoider->frontdir.dot(-(avoideeVector / avoideeDist)) < MAX_AVOIDEE_COSINE)
-			continue;
+			const bool avoideeMobile  = (avoideeMD != nullptr);
+			const bool avoideeMovable = (avoideeUD != nullptr && !static_cast<const CUnit*>(avoidee)->moveType->IsPushResistant());
+
+			const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoidee->pos + avoidee->speed);
+
+			// use the avoidee's MoveDef footprint as radius if it is mobile
+			// use the avoidee's Unit (not UnitDef) footprint as radius otherwise
+			const float avoideeRadius = avoideeMobile?
+				avoideeMD->CalcFootPrintMinExteriorRadius():
+				avoidee->CalcFootPrintMinExteriorRadius();
+			const float avoidanceRadiusSum = avoiderRadius + avoideeRadius;
+			const float avoidanceMassSum = avoider->mass + avoidee->mass;
+			const float avoideeMassScale = avoideeMobile? (avoidee->mass / avoidanceMassSum): 1.0f;
+			const float avoideeDistSq = avoideeVector.SqLength();
+			const float avoideeDist   = math::sqrt(avoideeDistSq) + 0.01f;
+
+			// do not bother steering around idling MOBILE objects
+			// (since collision handling will just push them aside)
+			if (avoideeMobile && avoideeMovable) {
+				if (!avoiderMD->avoidMobilesOnPath || (!avoidee->IsMoving() && avoidee->allyteam == avoider->allyteam))
+					continue;
+			}
 
-		if (avoideeDistSq >= Square(std::max(currentSpeed, 1.0f) * GAME_SPEED + avoidanceRadiusSum))
-			continue;
-		if (avoideeDistSq >= avoider->pos.SqDistance2D(goalPos))
-			continue;
+			// ignore objects that are more than this many degrees off-center from us
+			// NOTE:
+			//   if MAX_AVOIDEE_COSINE is too small, then this condition can be true
+			//   one frame and false the next (after avoider has turned) causing the
+			//   avoidance vector to oscillate --> units with turnInPlace = true will
+			//   slow to a crawl as a result
+			if (avoider->frontdir.dot(-(avoideeVector / avoideeDist)) < MAX_AVOIDEE_COSINE)
+				continue;
 
-		// if object and unit in relative motion are closing in on one another
-		// (or not yet fully apart), then the object is on the path of the unit
-		// and they are not collided
-		if (DEBUG_DRAWING_ENABLED) {
-			if (selectedUnitsHandler.selectedUnits.find(owner->id) != selectedUnitsHandler.selectedUnits.end()){
-				geometryLock.lock();
-				geometricObjects->AddLine(avoider->pos + (UpVector * 20.0f), avoidee->pos + (UpVector * 20.0f), 3, 1, 4);
-				geometryLock.unlock();
+			if (avoideeDistSq >= Square(std::max(currentSpeed, 1.0f) * GAME_SPEED + avoidanceRadiusSum))
+				continue;
+			if (avoideeDistSq >= avoider->pos.SqDistance2D(goalPos))
+				continue;
+
+			// if object and unit in relative motion are closing in on one another
+			// (or not yet fully apart), then the object is on the path of the unit
+			// and they are not collided
+			if (DEBUG_DRAWING_ENABLED) {
+				if (selectedUnitsHandler.selectedUnits.find(owner->id) != selectedUnitsHandler.selectedUnits.end()){
+					geometryLock.lock();
+					geometricObjects->AddLine(avoider->pos + (UpVector * 20.0f), avoidee->pos + (UpVector * 20.0f), 3, 1, 4);
+					geometryLock.unlock();
+				}
 			}
-		}
 
-		float avoiderTurnSign = -Sign(avoidee->pos.dot(avoider->rightdir) - avoider->pos.dot(avoider->rightdir));
-		float avoideeTurnSign = -Sign(avoider->pos.dot(avoidee->rightdir) - avoidee->pos.dot(avoidee->rightdir));
+			float avoiderTurnSign = -Sign(avoidee->pos.dot(avoider->rightdir) - avoider->pos.dot(avoider->rightdir));
+			float avoideeTurnSign = -Sign(avoider->pos.dot(avoidee->rightdir) - avoidee->pos.dot(avoidee->rightdir));
 
-		// for mobile units, avoidance-response is modulated by angle
-		// between avoidee's and avoider's frontdir such that maximal
-		// avoidance occurs when they are anti-parallel
-		const float avoidanceCosAngle = std::clamp(avoider->frontdir.dot(avoidee->frontdir), -1.0f, 1.0f);
-		const float avoidanceResponse = (1.0f - avoidanceCosAngle * int(avoideeMobile)) + 0.1f;
-		const float avoidanceFallOff  = (1.0f - std::min(1.0f, avoideeDist / (5.0f * avoidanceRadiusSum)));
+			// for mobile units, avoidance-response is modulated by angle
+			// between avoidee's and avoider's frontdir such that maximal
+			// avoidance occurs when they are anti-parallel
+			const float avoidanceCosAngle = std::clamp(avoider->frontdir.dot(avoidee->frontdir), -1.0f, 1.0f);
+			const float avoidanceResponse = (1.0f - avoidanceCosAngle * int(avoideeMobile)) + 0.1f;
+			const float avoidanceFallOff  = (1.0f - std::min(1.0f, avoideeDist / (5.0f * avoidanceRadiusSum)));
 
-		// if parties are anti-parallel, it is always more efficient for
-		// both to turn in the same local-space direction (either R/R or
-		// L/L depending on relative object positions) but there exists
-		// a range of orientations for which the signs are not equal
-		//
-		// (this is also true for the parallel situation, but there the
-		// degeneracy only occurs when one of the parties is behind the
-		// other and can be ignored)
-		if (avoidanceCosAngle < 0.0f)
-			avoiderTurnSign = std::max(avoiderTurnSign, avoideeTurnSign);
+			// if parties are anti-parallel, it is always more efficient for
+			// both to turn in the same local-space direction (either R/R or
+			// L/L depending on relative object positions) but there exists
+			// a range of orientations for which the signs are not equal
+			//
+			// (this is also true for the parallel situation, but there the
+			// degeneracy only occurs when one of the parties is behind the
+			// other and can be ignored)
+			if (avoidanceCosAngle < 0.0f)
+				avoiderTurnSign = std::max(avoiderTurnSign, avoideeTurnSign);
 
-		avoidanceDir = avoider->rightdir * AVOIDER_DIR_WEIGHT * avoiderTurnSign;
-		avoidanceVec += (avoidanceDir * avoidanceResponse * avoidanceFallOff * avoideeMassScale);
+			avoidanceDir = avoider->rightdir * AVOIDER_DIR_WEIGHT * avoiderTurnSign;
+			avoidanceVec += (avoidanceDir * avoidanceResponse * avoidanceFallOff * avoideeMassScale);
 
-		if (!avoidingUnits)
-			avoidingUnits = true;
+			if (!avoidingUnits)
+				avoidingUnits = true;
+		}
 	}
 
 	// use a weighted combination of the desired- and the avoidance-directions
@@ -1976,6 +1988,104 @@ float3 CGroundMoveType::GetObstacleAvoidanceDir(const float3& desiredDir) {
 	return (lastAvoidanceDir = avoidanceDir);
 }
 
+/*
+ * Avoidance against the aggregated contents of every SeparationField
+ * cell in range, one pseudo-avoidee per cell and layer. Mirrors the
+ * per-object response in GetObstacleAvoidanceDir, weighted by the
+ * number of units the cell holds.
+ */
+float3 CGroundMoveType::GetSeparationFieldAvoidanceVec(
+	const SeparationField& separationField,
+	float avoidanceRadius,
+	float avoiderRadius,
+	float maxAvoideeCosine
+) {
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	const CUnit* avoider = owner;
+	const MoveDef* avoiderMD = avoider->moveDef;
+
+	// the field also contains the avoider, take its contribution back out
+	// of the cell it was added to (its position may have changed since)
+	const SeparationField::Sample* avoiderSample = separationField.GetUnitSample(avoider);
+	const int avoiderCellIdx = (avoiderSample != nullptr && avoiderSample->layer >= 0)? avoiderSample->cellIdx: -1;
+	const int avoiderLayer = (avoiderSample != nullptr)? avoiderSample->layer: -1;
+
+	const int cellSize = separationField.GetCellSize();
+	const int xmin = std::max(int(avoider->pos.x - avoidanceRadius) / cellSize, 0);
+	const int zmin = std::max(int(avoider->pos.z - avoidanceRadius) / cellSize, 0);
+	const int xmax = std::min(int(avoider->pos.x + avoidanceRadius) / cellSize, separationField.GetNumCellsX() - 1);
+	const int zmax = std::min(int(avoider->pos.z + avoidanceRadius) / cellSize, separationField.GetNumCellsZ() - 1);
+
+	float3 avoidanceVec;
+
+	for (int layer = 0; layer < SeparationField::LAYER_COUNT; layer++) {
+		// do not bother steering around moving pushable units unless asked to
+		if (layer == SeparationField::LAYER_MOVERS && !avoiderMD->avoidMobilesOnPath)
+			continue;
+
+		for (int z = zmin; z <= zmax; z++) {
+			for (int x = xmin; x <= xmax; x++) {
+				SeparationField::Cell cell = separationField.GetCell(layer, x, z);
+
+				if ((z * separationField.GetNumCellsX() + x) == avoiderCellIdx && layer == avoiderLayer) {
+					assert(cell.count > 0);
+					cell.posSum -= avoiderSample->pos;
+					cell.speedSum -= avoiderSample->speed;
+					cell.frontSum -= avoiderSample->frontdir;
+					cell.massSum -= avoiderSample->mass;
+					cell.count -= 1;
+				}
+
+				if (cell.count == 0)
+					continue;
+				// everything in this cell would be crushed by the avoider
+				if (cell.maxCrushResistance <= avoiderMD->crushStrength)
+					continue;
+
+				const float invCount = 1.0f / cell.count;
+
+				const float3 avoideePos = cell.posSum * invCount;
+				const float3 avoideeSpeed = cell.speedSum * invCount;
+				const float3 avoideeFrontDir = (cell.frontSum * invCount).SafeNormalize2D();
+				const float3 avoideeRightDir = {-avoideeFrontDir.z, 0.0f, avoideeFrontDir.x};
+
+				if (avoideePos.SqDistance2D(avoider->pos) >= Square(avoidanceRadius + cell.maxRadius))
+					continue;
+
+				const float3 avoideeVector = (avoider->pos + avoider->speed) - (avoideePos + avoideeSpeed);
+
+				const float avoidanceRadiusSum = avoiderRadius + cell.maxRadius;
+				const float avoideeMassScale = cell.massSum / (avoider->mass + cell.massSum);
+				const float avoideeDistSq = avoideeVector.SqLength();
+				const float avoideeDist   = math::sqrt(avoideeDistSq) + 0.01f;
+
+				if (avoider->frontdir.dot(-(avoideeVector / avoideeDist)) < maxAvoideeCosine)
+					continue;
+
+				if (avoideeDistSq >= Square(std::max(currentSpeed, 1.0f) * GAME_SPEED + avoidanceRadiusSum))
+					continue;
+				if (avoideeDistSq >= avoider->pos.SqDistance2D(goalPos))
+					continue;
+
+				float avoiderTurnSign = -Sign(avoideePos.dot(avoider->rightdir) - avoider->pos.dot(avoider->rightdir));
+				float avoideeTurnSign = -Sign(avoider->pos.dot(avoideeRightDir) - avoideePos.dot(avoideeRightDir));
+
+				const float avoidanceCosAngle = std::clamp(avoider->frontdir.dot(avoideeFrontDir), -1.0f, 1.0f);
+				const float avoidanceResponse = (1.0f - avoidanceCosAngle) + 0.1f;
+				const float avoidanceFallOff  = (1.0f - std::min(1.0f, avoideeDist / (5.0f * avoidanceRadiusSum)));
+
+				if (avoidanceCosAngle < 0.0f)
+					avoiderTurnSign = std::max(avoiderTurnSign, avoideeTurnSign);
+
+				avoidanceVec += (avoider->rightdir * avoiderTurnSign * avoidanceResponse * avoidanceFallOff * avoideeMassScale * cell.count);
+			}
+		}
+	}
+
+	return avoidanceVec;
+}
+
 
 
 #if 0
@@ -3240,7 +3350,7 @@ float CGroundMoveType::GetGroundHeight(const float3& p) const
 	MoveDef *md = owner->moveDef;
 
 	// in [minHeight, maxHeight]
-	const float gh = CGround::GetHeightReal(p.x, p.z);
+	const float gh = GetGroundHeightReal(p);
 	
 	// in [-waterline, maxHeight], note that waterline
 	// can be much deeper than ground in shallow water
@@ -3254,6 +3364,23 @@ float CGroundMoveType::GetGroundHeight(const float3& p) const
 	return gh;
 }
 
+float CGroundMoveType::GetGroundHeightReal(const float3& p) const
+{
+	// idle and slow units sample the same spot frame after frame; the
+	// generation changes on every synced heightmap write so a hit is
+	// always identical to a fresh CGround::GetHeightReal
+	const uint32_t generation = readMap->GetHeightMapSyncedGeneration();
+
+	if (p.x == groundSampleX && p.z == groundSampleZ && generation == groundSampleGeneration)
+		return groundSampleHeight;
+
+	groundSampleX = p.x;
+	groundSampleZ = p.z;
+	groundSampleGeneration = generation;
+
+	return (groundSampleHeight = CGround::GetHeightReal(p.x, p.z));
+}
+
 void CGroundMoveType::AdjustPosToWaterLine()
 {
 	RECOIL_DETAILED_TRACY_ZONE;
@@ -3265,9 +3392,9 @@ void CGroundMoveType::AdjustPosToWaterLine()
 	if (modInfo.allowGroundUnitGravity) {
 		if (owner->FloatOnWater()) {
 			MoveDef *md = owner->moveDef;
-			owner->Move(UpVector * (std::max(CGround::GetHeightReal(owner->pos.x, owner->pos.z), -md->waterline) - owner->pos.y), true);
+			owner->Move(UpVector * (std::max(GetGroundHeightReal(owner->pos), -md->waterline) - owner->pos.y), true);
 		} else {
-			owner->Move(UpVector * (std::max(CGround::GetHeightReal(owner->pos.x, owner->pos.z), owner->pos.y) - owner->pos.y), true);
+			owner->Move(UpVector * (std::max(GetGroundHeightReal(owner->pos), owner->pos.y) - owner->pos.y), true);
 		}
 	} else {
 		owner->Move(UpVector * (GetGroundHeight(owner->pos) - owner->pos.y), true);
@@ -4,6 +4,7 @@
 #define GROUNDMOVETYPE_H
 
 #include <array>
+#include <limits>
 #include <tuple>
 
 #include "MoveType.h"
@@ -14,6 +15,10 @@ struct UnitDef;
 struct MoveDef;
 class CSolidObject;
 
+namespace MoveTypes {
+	class SeparationField;
+}
+
 class CGroundMoveType : public AMoveType
 {
 	CR_DECLARE_DERIVED(CGroundMoveType)
@@ -126,6 +131,7 @@ public:
 	const float3& GetFlatFrontDir() const { return flatFrontDir; }
 	const float3& GetGroundNormal(const float3&) const;
 	float GetGroundHeight(const float3&) const;
+	float GetGroundHeightReal(const float3&) const;
 
 	void SyncWaypoints() {
 		// Synced vars trigger a checksum update on change, which is expensive so we should check
@@ -149,6 +155,7 @@ public:
 
 private:
 	float3 GetObstacleAvoidanceDir(const float3& desiredDir);
+	float3 GetSeparationFieldAvoidanceVec(const MoveTypes::SeparationField& separationField, float avoidanceRadius, float avoiderRadius, float maxAvoideeCosine);
 	float3 Here() const;
 
 	// Start skidding if the angle between the vel and dir vectors is >arccos(2*sqSkidSpeedMult-1)/2
@@ -306,6 +313,13 @@ private:
 	bool positionStuck = false;
 	bool forceStaticObjectCheck = false;
 	bool avoidingUnits = false;
+
+	// last terrain sample taken by GetGroundHeightReal, reused while the
+	// owner stays put and the heightmap generation does not change
+	mutable float groundSampleX = std::numeric_limits<float>::quiet_NaN();
+	mutable float groundSampleZ = std::numeric_limits<float>::quiet_NaN();
+	mutable float groundSampleHeight = 0.0f;
+	mutable uint32_t groundSampleGeneration = 0;
 };
 
 #endif // GROUNDMOVETYPE_H
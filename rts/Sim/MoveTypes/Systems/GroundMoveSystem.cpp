@@ -6,6 +6,7 @@
 
 #include "Sim/Ecs/Registry.h"
 #include "Sim/Features/Feature.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/MoveTypes/Components/MoveTypesComponents.h"
 #include "Sim/Units/Unit.h"
@@ -18,7 +19,9 @@
 using namespace MoveTypes;
 
 void GroundMoveSystem::Init() {
-    Sim::systemGlobals.CreateSystemComponent<GroundMoveSystemComponent>();
+    auto& comp = Sim::systemGlobals.CreateSystemComponent<GroundMoveSystemComponent>();
+
+    comp.separationField.Init(modInfo.groundUnitSeparationFieldCellSize);
 }
 
 template<typename T, typename F>
@@ -36,6 +39,20 @@ void GroundMoveSystem::Update() {
 
     // TODO: GroundMove could become a component (or series of components) and then the extra indirection wouldn't be
     // needed. Though that will be a bigger change.
+    if (comp.separationField.IsEnabled()) {
+        SCOPED_TIMER("Sim::Unit::MoveType::0::BuildSeparationField");
+        auto view = Sim::registry.view<GroundMoveType>();
+
+        comp.separationFieldUnits.resize(view.size());
+        for_mt(0, view.size(), [&view, &comp](const int i){
+            auto entity = view.storage<GroundMoveType>()[i];
+            auto unitId = view.get<GroundMoveType>(entity);
+
+            comp.separationFieldUnits[i] = unitHandler.GetUnit(unitId.value);
+        });
+
+        comp.separationField.Build(comp.separationFieldUnits);
+    }
 	{
 		SCOPED_TIMER("Sim::Unit::MoveType::1::UpdateTraversalPlan");
         auto view = Sim::registry.view<GroundMoveType>();
@@ -0,0 +1,162 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "SeparationField.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Map/ReadMap.h"
+#include "Sim/MoveTypes/MoveDefHandler.h"
+#include "Sim/MoveTypes/MoveType.h"
+#include "Sim/Units/Unit.h"
+
+#include "System/Threading/ThreadPool.h"
+#include "System/Misc/TracyDefs.h"
+
+using namespace MoveTypes;
+
+void SeparationField::Init(int cellSize_) {
+	RECOIL_DETAILED_TRACY_ZONE;
+	Kill();
+
+	if (cellSize_ <= 0)
+		return;
+
+	cellSize = cellSize_;
+	numCellsX = (mapDims.mapx * SQUARE_SIZE + cellSize - 1) / cellSize;
+	numCellsZ = (mapDims.mapy * SQUARE_SIZE + cellSize - 1) / cellSize;
+
+	for (int layer = 0; layer < LAYER_COUNT; layer++) {
+		cells[layer].resize(numCellsX * numCellsZ);
+		dirtyCells[layer].reserve(256);
+	}
+}
+
+void SeparationField::Kill() {
+	for (int layer = 0; layer < LAYER_COUNT; layer++) {
+		cells[layer].clear();
+		dirtyCells[layer].clear();
+	}
+
+	samples.clear();
+	unitSampleIndices.clear();
+
+	cellSize = 0;
+	numCellsX = 0;
+	numCellsZ = 0;
+}
+
+int SeparationField::GetCellIdx(const float3& pos) const {
+	if (!pos.IsInBounds())
+		return -1;
+
+	const int x = std::clamp(int(pos.x) / cellSize, 0, numCellsX - 1);
+	const int z = std::clamp(int(pos.z) / cellSize, 0, numCellsZ - 1);
+
+	return (z * numCellsX + x);
+}
+
+SeparationField::Sample SeparationField::MakeSample(const CUnit* unit) {
+	Sample s;
+
+	// same (avoider-independent) filters GetObstacleAvoidanceDir
+	// applies to every avoidee, the rest is resolved per cell
+	if (unit->moveDef == nullptr)
+		return s;
+	if (unit->IsInAir() || unit->IsFlying())
+		return s;
+	if (!unit->HasCollidableStateBit(CSolidObject::CSTATE_BIT_SOLIDOBJECTS))
+		return s;
+	if (!unit->IsBlocking())
+		return s;
+
+	if (unit->moveType->IsPushResistant()) {
+		s.layer = LAYER_RESISTANT;
+	} else if (unit->IsMoving()) {
+		s.layer = LAYER_MOVERS;
+	} else {
+		// idling pushable units are left to the collision handler
+		return s;
+	}
+
+	s.pos = unit->pos;
+	s.speed = unit->speed;
+	s.frontdir = unit->frontdir;
+	s.mass = unit->mass;
+	s.radius = unit->moveDef->CalcFootPrintMinExteriorRadius();
+	s.crushResistance = unit->crushable? unit->crushResistance: std::numeric_limits<float>::infinity();
+
+	return s;
+}
+
+void SeparationField::Build(const std::vector<CUnit*>& units) {
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	if (!IsEnabled())
+		return;
+
+	for (const CUnit* unit: units) {
+		if (size_t(unit->id) >= unitSampleIndices.size())
+			unitSampleIndices.resize(unit->id + 1, -1);
+	}
+
+	samples.resize(units.size());
+
+	for_mt(0, units.size(), [&](const int i) {
+		samples[i] = MakeSample(units[i]);
+
+		if (samples[i].layer >= 0)
+			samples[i].cellIdx = GetCellIdx(samples[i].pos);
+	});
+
+	// units that died or stopped moving on the ground since the last
+	// Build are not in <units> anymore, reset every entry first
+	std::fill(unitSampleIndices.begin(), unitSampleIndices.end(), -1);
+
+	for (size_t i = 0; i < units.size(); i++) {
+		unitSampleIndices[units[i]->id] = i;
+	}
+
+	// every layer accumulates its samples in unit order, which
+	// keeps the per-cell sums independent of the thread count
+	for_mt(0, LAYER_COUNT, [&](const int layer) {
+		std::vector<Cell>& layerCells = cells[layer];
+		std::vector<int>& layerDirtyCells = dirtyCells[layer];
+
+		for (const int cellIdx: layerDirtyCells) {
+			layerCells[cellIdx] = {};
+		}
+
+		layerDirtyCells.clear();
+
+		for (const Sample& s: samples) {
+			if (s.layer != layer || s.cellIdx < 0)
+				continue;
+
+			Cell& c = layerCells[s.cellIdx];
+
+			if (c.count == 0)
+				layerDirtyCells.push_back(s.cellIdx);
+
+			c.posSum += s.pos;
+			c.speedSum += s.speed;
+			c.frontSum += s.frontdir;
+			c.massSum += s.mass;
+			c.maxRadius = std::max(c.maxRadius, s.radius);
+			c.maxCrushResistance = std::max(c.maxCrushResistance, s.crushResistance);
+			c.count += 1;
+		}
+	});
+}
+
+const SeparationField::Sample* SeparationField::GetUnitSample(const CUnit* unit) const {
+	if (size_t(unit->id) >= unitSampleIndices.size())
+		return nullptr;
+
+	const int sampleIdx = unitSampleIndices[unit->id];
+
+	if (sampleIdx < 0)
+		return nullptr;
+
+	return &samples[sampleIdx];
+}
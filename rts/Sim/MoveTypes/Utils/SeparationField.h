@@ -0,0 +1,103 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SEPARATION_FIELD_H__
+#define SEPARATION_FIELD_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "System/float3.h"
+
+class CUnit;
+
+namespace MoveTypes {
+
+/**
+ * Coarse per-frame density/velocity grid over all ground-moving units.
+ *
+ * Rebuilt once per sim frame (before any ground unit moves) so obstacle
+ * avoidance can steer around the aggregate of every cell in range rather
+ * than around each individual neighbour, which keeps the per-unit cost
+ * flat inside large blobs. Only used when the movement modrule
+ * groundUnitSeparationFieldCellSize is non-zero (it sets the cell size).
+ */
+class SeparationField {
+public:
+	enum Layer {
+		LAYER_MOVERS    = 0, // mobile units that are moving and can be pushed
+		LAYER_RESISTANT = 1, // push-resistant mobile units, moving or not
+		LAYER_COUNT     = 2,
+	};
+
+	struct Cell {
+		float3 posSum;
+		float3 speedSum;
+		float3 frontSum;
+
+		float massSum = 0.0f;
+		float maxRadius = 0.0f;
+		// units that cannot be crushed count as infinitely resistant
+		float maxCrushResistance = 0.0f;
+
+		uint32_t count = 0;
+	};
+
+	// the contribution of one unit to a cell
+	struct Sample {
+		float3 pos;
+		float3 speed;
+		float3 frontdir;
+
+		float mass = 0.0f;
+		float radius = 0.0f;
+		float crushResistance = 0.0f;
+
+		int cellIdx = -1;
+		int layer = -1;
+	};
+
+public:
+	void Init(int cellSize);
+	void Kill();
+
+	/**
+	 * Re-creates the grid from the current state of all units
+	 * in <units>; their order must be deterministic since it
+	 * determines the order of the floating-point accumulation.
+	 */
+	void Build(const std::vector<CUnit*>& units);
+
+	static Sample MakeSample(const CUnit* unit);
+
+	/**
+	 * Returns the sample <unit> contributed during the last Build, or
+	 * null if it was not part of it; the avoider's own contribution
+	 * must be taken back out of exactly the cell it was added to.
+	 */
+	const Sample* GetUnitSample(const CUnit* unit) const;
+
+	bool IsEnabled() const { return (cellSize > 0); }
+	int GetCellSize() const { return cellSize; }
+	int GetNumCellsX() const { return numCellsX; }
+	int GetNumCellsZ() const { return numCellsZ; }
+
+	int GetCellIdx(const float3& pos) const;
+
+	const Cell& GetCell(int layer, int x, int z) const { return cells[layer][z * numCellsX + x]; }
+
+private:
+	std::vector<Cell> cells[LAYER_COUNT];
+	std::vector<int> dirtyCells[LAYER_COUNT];
+
+	std::vector<Sample> samples;
+	// unit id to index into samples, -1 if not sampled
+	std::vector<int> unitSampleIndices;
+
+	int cellSize = 0;
+	int numCellsX = 0;
+	int numCellsZ = 0;
+};
+
+}
+
+#endif
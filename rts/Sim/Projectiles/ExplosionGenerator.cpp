@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <cassert>
@@ -600,132 +602,240 @@ bool CStdExplosionGenerator::Explosion(
 
 
 
-void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir)
+void CCustomExplosionGenerator::ExecuteExplosionCode(const ProjectileSpawnInfo& psi, float damage, char* instance, int spawnIndex, const float3& dir)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
+
+	if (psi.constOnly) {
+		// fast path, nothing to evaluate per projectile
+		for (const ExpGenOp& op: psi.ops) {
+			switch (op.type) {
+				case OP_SETI8 : { *(std::int8_t*)  (instance + op.offset) = op.arg.i; } break;
+				case OP_SETI16: { *(std::int16_t*) (instance + op.offset) = op.arg.i; } break;
+				case OP_SETI32: { *(std::int32_t*) (instance + op.offset) = op.arg.i; } break;
+				case OP_SETF32: { *(float*)        (instance + op.offset) = op.arg.f; } break;
+				case OP_SETP  : { *(void**)        (instance + op.offset) = op.arg.p; } break;
+				case OP_DIR   : { *reinterpret_cast<float3*>(instance + op.offset) = dir; } break;
+				default: { assert(false); } break;
+			}
+		}
+
+		return;
+	}
+
 	float val = 0.0f;
 	float buffer[16];
-	void* ptr = nullptr;
 
-	std::memset(&buffer[0], 0, sizeof(buffer));
+	if (psi.usesBuffer)
+		std::memset(&buffer[0], 0, sizeof(buffer));
+
+	for (const ExpGenOp& op: psi.ops) {
+		switch (op.type) {
+			case OP_STOREI8 : { *(std::int8_t*)  (instance + op.offset) = (int) val; val = 0.0f; } break;
+			case OP_STOREI16: { *(std::int16_t*) (instance + op.offset) = (int) val; val = 0.0f; } break;
+			case OP_STOREI32: { *(std::int32_t*) (instance + op.offset) = (int) val; val = 0.0f; } break;
+			case OP_STOREF32: { *(float*)        (instance + op.offset) =       val; val = 0.0f; } break;
 
-	for (;;) {
-		switch (*(code++)) {
-			case OP_END: {
-				return;
-			}
 			case OP_STOREI: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 1: { *(std::int8_t*)  (instance + offset) = (int) val; } break;
-					case 2: { *(std::int16_t*) (instance + offset) = (int) val; } break;
-					case 4: { *(std::int32_t*) (instance + offset) = (int) val; } break;
-					case 8: { *(std::int64_t*) (instance + offset) = (int) val; } break;
+				// sizes without a dedicated op (not produced by ParseExplosionCode)
+				switch (op.size) {
+					case 8: { *(std::int64_t*) (instance + op.offset) = (int) val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
-				break;
-			}
+			} break;
 			case OP_STOREF: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 4: { *(float*)  (instance + offset) = val; } break;
-					case 8: { *(double*) (instance + offset) = val; } break;
+				switch (op.size) {
+					case 8: { *(double*) (instance + op.offset) = val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
-				break;
-			}
-			case OP_ADD: {
-				val += *(float*) code;
-				code += 4;
-				break;
-			}
-			case OP_RAND: {
-				val += guRNG.NextFloat() * (*(float*) code);
-				code += 4;
-				break;
-			}
-			case OP_DAMAGE: {
-				val += damage * (*(float*) code);
-				code += 4;
-				break;
-			}
-			case OP_INDEX: {
-				val += spawnIndex * (*(float*) code);
-				code += 4;
-				break;
-			}
+			} break;
 
-			case OP_LOADP: {
-				ptr = *(void**) code;
-				code += sizeof(void*);
-				break;
-			}
-			case OP_STOREP: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*(void**) (instance + offset) = ptr;
-				ptr = nullptr;
-				break;
-			}
+			case OP_SETI8 : { *(std::int8_t*)  (instance + op.offset) = op.arg.i; } break;
+			case OP_SETI16: { *(std::int16_t*) (instance + op.offset) = op.arg.i; } break;
+			case OP_SETI32: { *(std::int32_t*) (instance + op.offset) = op.arg.i; } break;
+			case OP_SETF32: { *(float*)        (instance + op.offset) = op.arg.f; } break;
+			case OP_SETP  : { *(void**)        (instance + op.offset) = op.arg.p; } break;
+
+			case OP_ADD   : { val += op.arg.f;                         } break;
+			case OP_RAND  : { val += guRNG.NextFloat() * op.arg.f;     } break;
+			case OP_DAMAGE: { val += damage * op.arg.f;                } break;
+			case OP_INDEX : { val += spawnIndex * op.arg.f;            } break;
 
 			case OP_DIR: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*reinterpret_cast<float3*>(instance + offset) = dir;
-				break;
-			}
+				*reinterpret_cast<float3*>(instance + op.offset) = dir;
+			} break;
 			case OP_SAWTOOTH: {
 				// this translates to modulo except it works with floats
-				val -= (*(float*) code) * math::floor(val / (*(float*) code));
-				code += 4;
-				break;
-			}
+				val -= op.arg.f * math::floor(val / op.arg.f);
+			} break;
 			case OP_DISCRETE: {
-				val = (*(float*) code) * math::floor(spring::SafeDivide(val, (*(float*) code)));
-				code += 4;
-				break;
-			}
+				val = op.arg.f * math::floor(spring::SafeDivide(val, op.arg.f));
+			} break;
 			case OP_SINE: {
-				val = (*(float*) code) * math::sin(val);
-				code += 4;
-				break;
-			}
+				val = op.arg.f * math::sin(val);
+			} break;
 			case OP_YANK: {
-				buffer[(*(int*) code)] = val;
+				buffer[op.arg.i] = val;
 				val = 0;
-				code += 4;
-				break;
-			}
+			} break;
 			case OP_MULTIPLY: {
-				val *= buffer[(*(int*) code)];
-				code += 4;
-				break;
-			}
+				val *= buffer[op.arg.i];
+			} break;
 			case OP_ADDBUFF: {
-				val += buffer[(*(int*) code)];
-				code += 4;
-				break;
-			}
+				val += buffer[op.arg.i];
+			} break;
 			case OP_POW: {
-				val = math::pow(val, (*(float*) code));
-				code += 4;
-				break;
-			}
+				val = math::pow(val, op.arg.f);
+			} break;
 			case OP_POWBUFF: {
-				val = math::pow(val, buffer[(*(int*) code)]);
-				code += 4;
-				break;
-			}
+				val = math::pow(val, buffer[op.arg.i]);
+			} break;
 			default: {
 				assert(false);
-				break;
-			}
+			} break;
+		}
+	}
+}
+
+
+
+void CCustomExplosionGenerator::CompileExplosionCode(ProjectileSpawnInfo* psi, const std::string& code)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+
+	// decodes the byte-code emitted by ParseExplosionCode into a flat op list
+	// runs of OP_ADD's that end in a store are folded into a single constant
+	// store (evaluated in the same order, so results are bit-identical) and
+	// LOADP + STOREP pairs are fused
+	std::vector<ExpGenOp>& ops = psi->ops;
+	std::vector<ExpGenOp> pending;
+
+	ops.clear();
+	ops.reserve(code.size() / 4);
+
+	const char* cur = code.data();
+	const char* end = code.data() + code.size();
+
+	const auto Read = [&](auto& v) {
+		assert((cur + sizeof(v)) <= end);
+		std::memcpy(&v, cur, sizeof(v));
+		cur += sizeof(v);
+	};
+
+	void* ptr = nullptr;
+	bool foldable = true;
+
+	psi->usesBuffer = false;
+
+	while (cur < end) {
+		ExpGenOp op;
+		op.type = *(cur++);
+
+		switch (op.type) {
+			case OP_END: {
+				cur = end;
+			} break;
+
+			case OP_STOREI:
+			case OP_STOREF: {
+				Read(op.size);
+				Read(op.offset);
+
+				const bool isInt = (op.type == OP_STOREI);
+
+				if (foldable) {
+					float val = 0.0f;
+
+					for (const ExpGenOp& p: pending) {
+						val += p.arg.f;
+					}
+
+					switch (op.size | (isInt << 4)) {
+						case (1 | (1 << 4)): { op.type = OP_SETI8 ; op.arg.i = (int) val; } break;
+						case (2 | (1 << 4)): { op.type = OP_SETI16; op.arg.i = (int) val; } break;
+						case (4 | (1 << 4)): { op.type = OP_SETI32; op.arg.i = (int) val; } break;
+						case (4 | (0 << 4)): { op.type = OP_SETF32; op.arg.f =       val; } break;
+						default: {
+							// keep the generic store, it still needs the value
+							ops.insert(ops.end(), pending.begin(), pending.end());
+						} break;
+					}
+				} else {
+					ops.insert(ops.end(), pending.begin(), pending.end());
+
+					switch (op.size | (isInt << 4)) {
+						case (1 | (1 << 4)): { op.type = OP_STOREI8 ; } break;
+						case (2 | (1 << 4)): { op.type = OP_STOREI16; } break;
+						case (4 | (1 << 4)): { op.type = OP_STOREI32; } break;
+						case (4 | (0 << 4)): { op.type = OP_STOREF32; } break;
+						default: {} break;
+					}
+				}
+
+				ops.push_back(op);
+				pending.clear();
+				foldable = true;
+			} break;
+
+			case OP_ADD: {
+				Read(op.arg.f);
+				pending.push_back(op);
+			} break;
+
+			case OP_RAND:
+			case OP_DAMAGE:
+			case OP_INDEX:
+			case OP_SAWTOOTH:
+			case OP_DISCRETE:
+			case OP_SINE:
+			case OP_POW: {
+				Read(op.arg.f);
+				pending.push_back(op);
+				foldable = false;
+			} break;
+
+			case OP_YANK:
+			case OP_MULTIPLY:
+			case OP_ADDBUFF:
+			case OP_POWBUFF: {
+				Read(op.arg.i);
+				pending.push_back(op);
+				foldable = false;
+				psi->usesBuffer = true;
+			} break;
+
+			case OP_LOADP: {
+				Read(ptr);
+			} break;
+			case OP_STOREP: {
+				Read(op.offset);
+				op.type = OP_SETP;
+				op.arg.p = ptr;
+				ops.push_back(op);
+				ptr = nullptr;
+			} break;
+
+			case OP_DIR: {
+				Read(op.offset);
+				ops.push_back(op);
+			} break;
+
+			default: {
+				assert(false);
+				cur = end;
+			} break;
 		}
 	}
+
+	// trailing value ops without a store only matter for their side-effects
+	if (!foldable)
+		ops.insert(ops.end(), pending.begin(), pending.end());
+
+	psi->constOnly = std::all_of(ops.begin(), ops.end(), [](const ExpGenOp& op) {
+		return ((op.type >= OP_SETI8 && op.type <= OP_SETP) || op.type == OP_DIR);
+	});
 }
 
 
@@ -922,8 +1032,7 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 		}
 
 		code += (char)OP_END;
-		psi.code.resize(code.size());
-		copy(code.begin(), code.end(), psi.code.begin());
+		CompileExplosionCode(&psi, code);
 
 		expGenParams.projectiles.push_back(psi);
 	}
@@ -1001,7 +1110,7 @@ bool CCustomExplosionGenerator::Explosion(
 
 		for (unsigned int c = 0; c < psi.count; c++) {
 			CExpGenSpawnable* projectile = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
-			ExecuteExplosionCode(&psi.code[0], damage, (char*) projectile, c, dir);
+			ExecuteExplosionCode(psi, damage, (char*) projectile, c, dir);
 			projectile->Init(owner, pos);
 		}
 	}
@@ -3,6 +3,7 @@
 #ifndef EXPLOSION_GENERATOR_H
 #define EXPLOSION_GENERATOR_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -143,6 +144,19 @@ public:
 class CCustomExplosionGenerator: public IExplosionGenerator
 {
 protected:
+	/// one pre-decoded instruction of a spawn's execution plan
+	struct ExpGenOp {
+		std::uint8_t type = 0;
+		std::uint8_t size = 0;    ///< member size for the generic stores
+		std::uint16_t offset = 0; ///< member offset for all stores
+
+		union {
+			float f;
+			int i;
+			void* p;
+		} arg = {0.0f};
+	};
+
 	struct ProjectileSpawnInfo {
 		unsigned int spawnableID = 0;
 
@@ -150,8 +164,13 @@ protected:
 		unsigned int count = 0;
 		unsigned int flags = 0;
 
-		/// parsed explosion script code
-		std::vector<char> code;
+		/// execution plan compiled from the parsed explosion script code
+		std::vector<ExpGenOp> ops;
+
+		/// true if the plan only writes constants (and the direction)
+		bool constOnly = false;
+		/// true if the plan uses the yank-buffer
+		bool usesBuffer = false;
 	};
 
 	struct ExpGenParams {
@@ -214,11 +233,23 @@ public:
 		OP_ADDBUFF  = 16, // Adds buffer value
 		OP_POW      = 17, // Power with code as exponent
 		OP_POWBUFF  = 18, // Power with buffer as exponent
+
+		// execution plan only, see CompileExplosionCode
+		OP_STOREI8  = 19, // store val as int8, reset val
+		OP_STOREI16 = 20, // store val as int16, reset val
+		OP_STOREI32 = 21, // store val as int32, reset val
+		OP_STOREF32 = 22, // store val as float, reset val
+		OP_SETI8    = 23, // store a folded constant as int8
+		OP_SETI16   = 24, // store a folded constant as int16
+		OP_SETI32   = 25, // store a folded constant as int32
+		OP_SETF32   = 26, // store a folded constant as float
+		OP_SETP     = 27, // store a constant void* (fused LOADP + STOREP)
 	};
 
 private:
 	void ParseExplosionCode(ProjectileSpawnInfo* psi, const std::string& script, SExpGenSpawnableMemberInfo& memberInfo, std::string& code);
-	void ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir);
+	void CompileExplosionCode(ProjectileSpawnInfo* psi, const std::string& code);
+	void ExecuteExplosionCode(const ProjectileSpawnInfo& psi, float damage, char* instance, int spawnIndex, const float3& dir);
 
 protected:
 	ExpGenParams expGenParams;
@@ -55,7 +55,11 @@ CR_REG_METADATA(CProjectileHandler, (
 	CR_MEMBER(maxNanoParticles),
 	CR_MEMBER(currentNanoParticles),
 	CR_MEMBER_UN(frameCurrentParticles),
-	CR_MEMBER_UN(frameProjectileCounts)
+	CR_MEMBER_UN(frameProjectileCounts),
+
+	CR_IGNORED(groundColPosX),
+	CR_IGNORED(groundColPosZ),
+	CR_IGNORED(groundColHeights)
 ))
 
 
@@ -354,6 +358,27 @@ void CProjectileHandler::Update()
 		frameProjectileCounts[true] = projectiles[true].size();
 		frameProjectileCounts[false] = projectiles[false].size();
 	}
+
+	{
+		// pool occupancy; fragmentation is the share of allocated pages not in use
+		static constexpr const char* sizeClassPlotNames[] = {
+			"ProjMemPool::UsedPages[S0]",
+			"ProjMemPool::UsedPages[S1]",
+			"ProjMemPool::UsedPages[S]",
+		};
+
+		static_assert(std::size(sizeClassPlotNames) == ProjMemPool::NUM_CLASSES(), "");
+
+		const size_t allocSize = projMemPool.alloc_size();
+
+		TracyPlot("ProjMemPool::UsedKB", int64_t(projMemPool.used_size() >> 10));
+		TracyPlot("ProjMemPool::PeakKB", int64_t(projMemPool.peak_size() >> 10));
+		TracyPlot("ProjMemPool::Fragmentation", (allocSize > 0)? (projMemPool.freed_size() * 100.0f / allocSize): 0.0f);
+
+		for (size_t i = 0; i < ProjMemPool::NUM_CLASSES(); i++) {
+			TracyPlot(sizeClassPlotNames[i], int64_t(projMemPool.used_pages(i)));
+		}
+	}
 }
 
 void CProjectileHandler::AddProjectile(CProjectile* p)
@@ -528,6 +553,9 @@ void CProjectileHandler::CheckShieldCollisions(
 
 	CollisionQuery cq;
 
+	const float3 rpvec = ppos0 - ppos1;
+	const float rpLenSq = std::max(rpvec.SqLength(), 1e-6f);
+
 	for (CPlasmaRepulser* repulser: tempRepulsers) {
 		assert(repulser != nullptr);
 
@@ -540,10 +568,26 @@ void CProjectileHandler::CheckShieldCollisions(
 		// increase its length.
 		// it's not 100% accurate so there's a bit of a FIXME here to do a real
 		// solution (keep track in the projectile which shields it's in)
-		const float3 rpvec  = ppos0 - ppos1;
-		const float3 rppos0 = ppos0 + rpvec * repulser->GetDeltaDist();
+		const float rpdelta = repulser->GetDeltaDist();
+		const float3 rppos0 = ppos0 + rpvec * rpdelta;
 		const float3 cvpos  = repulser->weaponMuzzlePos - repulser->owner->relMidPos;
 
+		{
+			// cheap sphere tests that settle most candidates without the matrix
+			// transforms in DetectHit; the margins keep both strictly on the safe
+			// side of the exact test, anything near the surface still goes there
+			const float shieldRadius = repulser->collisionVolume.GetBoundingRadius();
+			const float3 cdir = repulser->weaponMuzzlePos - ppos1;
+			const float3 cvec = cdir - rpvec * std::clamp(cdir.dot(rpvec) / rpLenSq, 0.0f, 1.0f + rpdelta);
+
+			// segment passes entirely outside the sphere
+			if (cvec.SqLength() > Square(shieldRadius * 1.01f + 1.0f))
+				continue;
+			// segment starts well inside a shield that ignores interior hits
+			if (rppos0.SqDistance(repulser->weaponMuzzlePos) < Square(std::max(shieldRadius * 0.99f - 1.0f, 0.0f)) && repulser->IgnoreInteriorHit(wpro))
+				continue;
+		}
+
 		// shield volumes are always spherical, transform directly
 		// (CollisionHandler will cancel out the relmidpos offset)
 		if (!CCollisionHandler::DetectHit(repulser->owner, &repulser->collisionVolume, CMatrix44f{cvpos}, rppos0, ppos1, &cq))
@@ -575,7 +619,10 @@ void CProjectileHandler::CheckUnitFeatureCollisions(bool synced)
 		const float3 ppos1 = p->pos + p->speed;
 		// const float3 ppos1 = p->pos + p->dir * (p->speed.w + p->radius);
 
-		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, &tempRepulsers);
+		// only gather shields for projectiles that any shield could intercept
+		const bool shieldable = (p->weapon && static_cast<const CWeaponProjectile*>(p)->GetWeaponDef()->interceptedByShieldType != 0);
+
+		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, shieldable? &tempRepulsers: nullptr);
 
 		CheckShieldCollisions (p, tempRepulsers, ppos0, ppos1); tempRepulsers.clear();
 		CheckUnitCollisions   (p, tempUnits    , ppos0, ppos1); tempUnits.clear();
@@ -586,45 +633,78 @@ void CProjectileHandler::CheckUnitFeatureCollisions(bool synced)
 void CProjectileHandler::CheckGroundCollisions(bool synced)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	//can't use iterators here, because instructions inside the loop modify projectiles[synced]
-	for (size_t i = 0; i < projectiles[synced].size(); ++i) {
-		CProjectile* p = projectiles[synced][i];
+	auto& pc = projectiles[synced];
 
-		if (!p->checkCol)
-			continue;
+	// Collision() can add new projectiles (e.g. CEG spawns), these are
+	// appended to <pc> and have to be checked as well, in another batch
+	for (size_t batchBeg = 0, batchEnd = pc.size(); batchBeg < batchEnd; batchBeg = batchEnd, batchEnd = pc.size()) {
+		const size_t batchSize = batchEnd - batchBeg;
 
-		// NOTE:
-		//   if <p> is a MissileProjectile and does not have
-		//   selfExplode set, tbis will cause it to never be
-		//   removed (!)
-		if (p->GetCollisionFlags() & Collision::NOGROUND)
-			continue;
+		groundColPosX.resize(batchSize);
+		groundColPosZ.resize(batchSize);
+		groundColHeights.resize(batchSize);
 
-		// don't collide with ground yet if last update scheduled a bounce
-		if (p->weapon && static_cast<const CWeaponProjectile*>(p)->HasScheduledBounce())
-			continue;
+		for (size_t i = 0; i < batchSize; ++i) {
+			const CProjectile* p = pc[batchBeg + i];
 
-		// NOTE:
-		//   don't add p->radius to groundHeight, or most (esp. modelled)
-		//   projectiles will collide with the ground one or more frames
-		//   too early
-		const float px = p->pos.x;
-		const float py = p->pos.y;
-		const float pz = p->pos.z;
-		const float gy = CGround::GetHeightReal(px, pz);
+			groundColPosX[i] = p->pos.x;
+			groundColPosZ[i] = p->pos.z;
+		}
 
-		const bool belowGround = (py < gy);
-		const bool insideWater = (py <= CGround::GetWaterLevel(px, pz));
+		// sampling the heightmap is read-only, split it over threads if worthwhile
+		// (always from the synced heightmap, as before, so results are identical)
+		if (batchSize >= GROUND_COL_BATCH_SIZE * 2) {
+			const int numChunks = (batchSize + GROUND_COL_BATCH_SIZE - 1) / GROUND_COL_BATCH_SIZE;
 
-		if (!belowGround && (!insideWater || p->ignoreWater))
-			continue;
+			for_mt(0, numChunks, [&](const int chunk) {
+				const size_t chunkBeg = chunk * GROUND_COL_BATCH_SIZE;
+				const size_t chunkLen = std::min(GROUND_COL_BATCH_SIZE, batchSize - chunkBeg);
 
-		// if position has dropped below terrain or into water
-		// where we can not live, adjust it and explode us now
-		// (if the projectile does not set deleteMe = true, it
-		// will keep hugging the terrain)
-		p->SetPosition((p->pos * XZVector) + (UpVector * mix(py, gy, belowGround)));
-		p->Collision();
+				CGround::GetHeightsReal(&groundColPosX[chunkBeg], &groundColPosZ[chunkBeg], &groundColHeights[chunkBeg], chunkLen);
+			});
+		} else {
+			CGround::GetHeightsReal(groundColPosX.data(), groundColPosZ.data(), groundColHeights.data(), batchSize);
+		}
+
+		// can't use iterators here, because Collision() modifies projectiles[synced]
+		for (size_t i = 0; i < batchSize; ++i) {
+			CProjectile* p = pc[batchBeg + i];
+
+			// NOTE:
+			//   don't add p->radius to groundHeight, or most (esp. modelled)
+			//   projectiles will collide with the ground one or more frames
+			//   too early
+			const float py = p->pos.y;
+			const float gy = groundColHeights[i];
+
+			const bool belowGround = (py < gy);
+			const bool insideWater = (py <= CGround::GetWaterLevel(groundColPosX[i], groundColPosZ[i]));
+
+			if (!belowGround && (!insideWater || p->ignoreWater))
+				continue;
+
+			// checked only for candidates, a previous Collision() might have changed these
+			if (!p->checkCol)
+				continue;
+
+			// NOTE:
+			//   if <p> is a MissileProjectile and does not have
+			//   selfExplode set, tbis will cause it to never be
+			//   removed (!)
+			if (p->GetCollisionFlags() & Collision::NOGROUND)
+				continue;
+
+			// don't collide with ground yet if last update scheduled a bounce
+			if (p->weapon && static_cast<const CWeaponProjectile*>(p)->HasScheduledBounce())
+				continue;
+
+			// if position has dropped below terrain or into water
+			// where we can not live, adjust it and explode us now
+			// (if the projectile does not set deleteMe = true, it
+			// will keep hugging the terrain)
+			p->SetPosition((p->pos * XZVector) + (UpVector * mix(py, gy, belowGround)));
+			p->Collision();
+		}
 	}
 }
 
@@ -115,6 +115,13 @@ private:
 	// [1] contains only projectiles that can     change simulation state
 	spring::FreeListMapCompact<CProjectile*, int> projectiles[2];
 
+	// SoA scratch buffers for the batched ground-collision pass
+	std::vector<float> groundColPosX;
+	std::vector<float> groundColPosZ;
+	std::vector<float> groundColHeights;
+
+	static constexpr size_t GROUND_COL_BATCH_SIZE = 1024;
+
 	static uint32_t UnsyncedRandInt(uint32_t N);
 	static uint32_t   SyncedRandInt(uint32_t N);
 
@@ -3,20 +3,25 @@
 #ifndef PROJECTILE_MEMPOOL_H
 #define PROJECTILE_MEMPOOL_H
 
+#include <algorithm>
+
 #include "Sim/Misc/GlobalConstants.h"
 #include "System/MemPoolTypes.h"
 #include "System/SpringMath.h"
 
+#include "Rendering/Env/Particles/Classes/SmokeProjectile2.h"
+#include "Sim/Projectiles/WeaponProjectiles/MissileProjectile.h"
 #include "Sim/Projectiles/WeaponProjectiles/StarburstProjectile.h"
 
 static constexpr size_t PMP_ALIGN = 8; // smallest that fits the needs of all the various projectile types
-static constexpr size_t PMP_S = AlignUp(sizeof(CStarburstProjectile), PMP_ALIGN); //biggest in size
 
-#if (defined(__x86_64) || defined(__x86_64__) || defined(_M_X64))
-typedef StaticMemPool<MAX_PROJECTILES, PMP_S, PMP_ALIGN> ProjMemPool;
-#else
-typedef FixedDynMemPool<PMP_S, MAX_PROJECTILES / 2000, MAX_PROJECTILES / 64, PMP_ALIGN> ProjMemPool;
-#endif
+// size classes; the bulk of the particle types and groundflashes fit into the
+// first, most weapon projectiles into the second and only a few into the last
+static constexpr size_t PMP_S0 = AlignUp(sizeof(CSmokeProjectile2), PMP_ALIGN);
+static constexpr size_t PMP_S1 = std::max(PMP_S0, AlignUp(sizeof(CMissileProjectile), PMP_ALIGN));
+static constexpr size_t PMP_S  = std::max(PMP_S1, AlignUp(sizeof(CStarburstProjectile), PMP_ALIGN)); //biggest in size
+
+typedef SizeClassMemPool<MAX_PROJECTILES / 128, PMP_ALIGN, PMP_S0, PMP_S1, PMP_S> ProjMemPool;
 
 extern ProjMemPool projMemPool;
 
@@ -199,6 +199,159 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 
 		scriptIndex[pair.second] = fn;
 	}
+
+	fireScripts.resize(scriptNames.size(), 0);
+
+	for (int i = 0; i < MAX_WEAPONS_PER_UNIT; ++i) {
+		const int fn = scriptIndex[COBFN_FirePrimary + COBFN_Weapon_Funcs * i];
+
+		if (fn < 0)
+			continue;
+
+		fireScripts[fn] = 1;
+	}
+
+	DecodeInstructions();
+}
+
+
+void CCobFile::DecodeInstructions()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	using namespace CobOpcodes;
+
+	const int numWords = static_cast<int>(code.size());
+	const int numScripts = static_cast<int>(scriptNames.size());
+
+	instructions.clear();
+	instructions.resize(numWords);
+
+	// jumps and calls may target any word, so decode starting at each one
+	// rather than just following the instruction boundaries of each script
+	for (int pc = 0; pc < numWords; ++pc) {
+		CobInstruction& ins = instructions[pc];
+
+		int op = CobInstruction::OP_UNKNOWN;
+		int numOperands = 0;
+
+		#define DECODE(raw, decoded, n) case raw: { op = CobInstruction::OP_##decoded; numOperands = n; } break;
+		switch (code[pc]) {
+			DECODE(MOVE,                 MOVE,                 2)
+			DECODE(TURN,                 TURN,                 2)
+			DECODE(SPIN,                 SPIN,                 2)
+			DECODE(STOP_SPIN,            STOP_SPIN,            2)
+			DECODE(SHOW,                 SHOW,                 1)
+			DECODE(HIDE,                 HIDE,                 1)
+			DECODE(CACHE,                NOP,                  1)
+			DECODE(DONT_CACHE,           NOP,                  1)
+			DECODE(MOVE_NOW,             MOVE_NOW,             2)
+			DECODE(TURN_NOW,             TURN_NOW,             2)
+			DECODE(SHADE,                NOP,                  1)
+			DECODE(DONT_SHADE,           NOP,                  1)
+			DECODE(EMIT_SFX,             EMIT_SFX,             1)
+
+			DECODE(WAIT_TURN,            WAIT_TURN,            2)
+			DECODE(WAIT_MOVE,            WAIT_MOVE,            2)
+			DECODE(SLEEP,                SLEEP,                0)
+
+			DECODE(PUSH_CONSTANT,        PUSH_CONSTANT,        1)
+			DECODE(PUSH_LOCAL_VAR,       PUSH_LOCAL_VAR,       1)
+			DECODE(PUSH_STATIC,          PUSH_STATIC,          1)
+			DECODE(CREATE_LOCAL_VAR,     CREATE_LOCAL_VAR,     0)
+			DECODE(POP_LOCAL_VAR,        POP_LOCAL_VAR,        1)
+			DECODE(POP_STATIC,           POP_STATIC,           1)
+			DECODE(POP_STACK,            POP_STACK,            0)
+
+			DECODE(ADD,                  ADD,                  0)
+			DECODE(SUB,                  SUB,                  0)
+			DECODE(MUL,                  MUL,                  0)
+			DECODE(DIV,                  DIV,                  0)
+			DECODE(MOD,                  MOD,                  0)
+			DECODE(BITWISE_AND,          BITWISE_AND,          0)
+			DECODE(BITWISE_OR,           BITWISE_OR,           0)
+			DECODE(BITWISE_XOR,          BITWISE_XOR,          0)
+			DECODE(BITWISE_NOT,          BITWISE_NOT,          0)
+
+			DECODE(RAND,                 RAND,                 0)
+			DECODE(GET_UNIT_VALUE,       GET_UNIT_VALUE,       0)
+			DECODE(GET,                  GET,                  0)
+
+			DECODE(SET_LESS,             SET_LESS,             0)
+			DECODE(SET_LESS_OR_EQUAL,    SET_LESS_OR_EQUAL,    0)
+			DECODE(SET_GREATER,          SET_GREATER,          0)
+			DECODE(SET_GREATER_OR_EQUAL, SET_GREATER_OR_EQUAL, 0)
+			DECODE(SET_EQUAL,            SET_EQUAL,            0)
+			DECODE(SET_NOT_EQUAL,        SET_NOT_EQUAL,        0)
+			DECODE(LOGICAL_AND,          LOGICAL_AND,          0)
+			DECODE(LOGICAL_OR,           LOGICAL_OR,           0)
+			DECODE(LOGICAL_XOR,          LOGICAL_XOR,          0)
+			DECODE(LOGICAL_NOT,          LOGICAL_NOT,          0)
+
+			DECODE(START,                START,                2)
+			DECODE(CALL,                 REAL_CALL,            2)
+			DECODE(REAL_CALL,            REAL_CALL,            2)
+			DECODE(LUA_CALL,             LUA_CALL,             2)
+			DECODE(JUMP,                 JUMP,                 1)
+			DECODE(RETURN,               RETURN,               0)
+			DECODE(JUMP_NOT_EQUAL,       JUMP_NOT_EQUAL,       1)
+			DECODE(SIGNAL,               SIGNAL,               0)
+			DECODE(SET_SIGNAL_MASK,      SET_SIGNAL_MASK,      0)
+
+			DECODE(EXPLODE,              EXPLODE,              1)
+			DECODE(PLAY_SOUND,           PLAY_SOUND,           1)
+
+			DECODE(SET,                  SET,                  0)
+			DECODE(ATTACH,               ATTACH,               0)
+			DECODE(DROP,                 DROP,                 0)
+			default: {} break;
+		}
+		#undef DECODE
+
+		// the interpreter used to throw when reading past the end (mantis #5981)
+		if ((pc + numOperands) >= numWords) {
+			ins.op = CobInstruction::OP_TRUNCATED;
+			continue;
+		}
+
+		ins.op = op;
+		ins.len = 1 + numOperands;
+		ins.a = (numOperands > 0)? code[pc + 1]: code[pc];
+		ins.b = (numOperands > 1)? code[pc + 2]: 0;
+
+		switch (ins.op) {
+			case CobInstruction::OP_PUSH_STATIC: {
+				if (static_cast<unsigned int>(ins.a) >= static_cast<unsigned int>(numStaticVars))
+					ins.op = CobInstruction::OP_NOP;
+			} break;
+			case CobInstruction::OP_POP_STATIC: {
+				if (static_cast<unsigned int>(ins.a) >= static_cast<unsigned int>(numStaticVars))
+					ins.op = CobInstruction::OP_POP_STACK;
+			} break;
+
+			case CobInstruction::OP_START:
+			case CobInstruction::OP_REAL_CALL: {
+				if (ins.a < 0 || ins.a >= numScripts) {
+					ins.op = CobInstruction::OP_UNKNOWN;
+					ins.len = 1;
+					ins.a = code[pc];
+					break;
+				}
+
+				// plain calls into lua_* functions are forwarded to LuaRules
+				if (code[pc] == CALL && scriptNames[ins.a].find("lua_") == 0) {
+					ins.op = CobInstruction::OP_LUA_CALL;
+					break;
+				}
+
+				// neither starting nor calling zero-length functions does anything
+				if (scriptLengths[ins.a] == 0)
+					ins.op = CobInstruction::OP_NOP;
+			} break;
+
+			default: {
+			} break;
+		}
+	}
 }
 
 
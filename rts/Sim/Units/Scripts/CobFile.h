@@ -8,6 +8,7 @@
 #include <string>
 
 #include "Lua/LuaHashString.h"
+#include "CobInstructions.h"
 #include "CobScriptNames.h"
 #include "System/UnorderedMap.hpp"
 
@@ -23,6 +24,7 @@ public:
 		numStaticVars = f.numStaticVars;
 
 		code = std::move(f.code);
+		instructions = std::move(f.instructions);
 		scriptNames = std::move(f.scriptNames);
 		scriptOffsets = std::move(f.scriptOffsets);
 
@@ -32,6 +34,7 @@ public:
 		sounds = std::move(f.sounds);
 		luaScripts = std::move(f.luaScripts);
 		scriptMap = std::move(f.scriptMap);
+		fireScripts = std::move(f.fireScripts);
 
 		name = std::move(f.name);
 		return *this;
@@ -39,10 +42,17 @@ public:
 
 	int GetFunctionId(const std::string& name);
 
+	bool IsFireScript(int functionId) const { return fireScripts[functionId]; }
+
+private:
+	void DecodeInstructions();
+
 public:
 	int numStaticVars = 0;
 
 	std::vector<int> code;
+	/// code decoded once at load, one instruction per word of <code>
+	std::vector<CobInstruction> instructions;
 	std::vector<std::string> scriptNames;
 	std::vector<int> scriptOffsets;
 	/// Assumes that the scripts are sorted by offset in the file
@@ -52,6 +62,8 @@ public:
 	std::vector<int> sounds;
 	std::vector<LuaHashString> luaScripts;
 	spring::unordered_map<std::string, int> scriptMap;
+	/// whether each function is one of the FirePrimary/Secondary/... handlers
+	std::vector<uint8_t> fireScripts;
 
 	std::string name;
 };
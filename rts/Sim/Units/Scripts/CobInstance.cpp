@@ -78,6 +78,10 @@ void CCobInstance::PostLoad()
 
 	cobFile = cobFileHandler->GetCobFile(unit->unitDef->scriptName);
 
+	// static var accesses are bounds-checked against the file when it is
+	// decoded, not against this instance (no-op unless the script changed)
+	staticVars.resize(cobFile->numStaticVars, 0);
+
 	for (int threadID: threadIDs) {
 		CCobThread* t = cobEngine->GetThread(threadID);
 
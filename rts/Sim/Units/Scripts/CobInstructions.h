@@ -0,0 +1,176 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef COB_INSTRUCTIONS_H
+#define COB_INSTRUCTIONS_H
+
+#include <cstdint>
+
+// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
+// And some information from basm0.8 source (basm ops.txt)
+namespace CobOpcodes {
+	// Model interaction
+	static constexpr int MOVE       = 0x10001000;
+	static constexpr int TURN       = 0x10002000;
+	static constexpr int SPIN       = 0x10003000;
+	static constexpr int STOP_SPIN  = 0x10004000;
+	static constexpr int SHOW       = 0x10005000;
+	static constexpr int HIDE       = 0x10006000;
+	static constexpr int CACHE      = 0x10007000;
+	static constexpr int DONT_CACHE = 0x10008000;
+	static constexpr int MOVE_NOW   = 0x1000B000;
+	static constexpr int TURN_NOW   = 0x1000C000;
+	static constexpr int SHADE      = 0x1000D000;
+	static constexpr int DONT_SHADE = 0x1000E000;
+	static constexpr int EMIT_SFX   = 0x1000F000;
+
+	// Blocking operations
+	static constexpr int WAIT_TURN  = 0x10011000;
+	static constexpr int WAIT_MOVE  = 0x10012000;
+	static constexpr int SLEEP      = 0x10013000;
+
+	// Stack manipulation
+	static constexpr int PUSH_CONSTANT    = 0x10021001;
+	static constexpr int PUSH_LOCAL_VAR   = 0x10021002;
+	static constexpr int PUSH_STATIC      = 0x10021004;
+	static constexpr int CREATE_LOCAL_VAR = 0x10022000;
+	static constexpr int POP_LOCAL_VAR    = 0x10023002;
+	static constexpr int POP_STATIC       = 0x10023004;
+	static constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
+
+	// Arithmetic operations
+	static constexpr int ADD         = 0x10031000;
+	static constexpr int SUB         = 0x10032000;
+	static constexpr int MUL         = 0x10033000;
+	static constexpr int DIV         = 0x10034000;
+	static constexpr int MOD         = 0x10034001; ///< spring specific
+	static constexpr int BITWISE_AND = 0x10035000;
+	static constexpr int BITWISE_OR  = 0x10036000;
+	static constexpr int BITWISE_XOR = 0x10037000;
+	static constexpr int BITWISE_NOT = 0x10038000;
+
+	// Native function calls
+	static constexpr int RAND           = 0x10041000;
+	static constexpr int GET_UNIT_VALUE = 0x10042000;
+	static constexpr int GET            = 0x10043000;
+
+	// Comparison
+	static constexpr int SET_LESS             = 0x10051000;
+	static constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
+	static constexpr int SET_GREATER          = 0x10053000;
+	static constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
+	static constexpr int SET_EQUAL            = 0x10055000;
+	static constexpr int SET_NOT_EQUAL        = 0x10056000;
+	static constexpr int LOGICAL_AND          = 0x10057000;
+	static constexpr int LOGICAL_OR           = 0x10058000;
+	static constexpr int LOGICAL_XOR          = 0x10059000;
+	static constexpr int LOGICAL_NOT          = 0x1005A000;
+
+	// Flow control
+	static constexpr int START           = 0x10061000;
+	static constexpr int CALL            = 0x10062000; ///< resolved to REAL_CALL or LUA_CALL when decoded
+	static constexpr int REAL_CALL       = 0x10062001; ///< spring custom
+	static constexpr int LUA_CALL        = 0x10062002; ///< spring custom
+	static constexpr int JUMP            = 0x10064000;
+	static constexpr int RETURN          = 0x10065000;
+	static constexpr int JUMP_NOT_EQUAL  = 0x10066000;
+	static constexpr int SIGNAL          = 0x10067000;
+	static constexpr int SET_SIGNAL_MASK = 0x10068000;
+
+	// Piece destruction
+	static constexpr int EXPLODE    = 0x10071000;
+	static constexpr int PLAY_SOUND = 0x10072000;
+
+	// Special functions
+	static constexpr int SET    = 0x10082000;
+	static constexpr int ATTACH = 0x10083000;
+	static constexpr int DROP   = 0x10084000;
+}
+
+
+// every raw opcode decodes to the op of the same name, except for CALL
+// (REAL_CALL or LUA_CALL) and the cases noted below
+#define COB_INSTRUCTION_LIST(X) \
+	X(MOVE)                 \
+	X(TURN)                 \
+	X(SPIN)                 \
+	X(STOP_SPIN)            \
+	X(SHOW)                 \
+	X(HIDE)                 \
+	X(MOVE_NOW)             \
+	X(TURN_NOW)             \
+	X(EMIT_SFX)             \
+	X(WAIT_TURN)            \
+	X(WAIT_MOVE)            \
+	X(SLEEP)                \
+	X(PUSH_CONSTANT)        \
+	X(PUSH_LOCAL_VAR)       \
+	X(PUSH_STATIC)          \
+	X(CREATE_LOCAL_VAR)     \
+	X(POP_LOCAL_VAR)        \
+	X(POP_STATIC)           \
+	X(POP_STACK)            \
+	X(ADD)                  \
+	X(SUB)                  \
+	X(MUL)                  \
+	X(DIV)                  \
+	X(MOD)                  \
+	X(BITWISE_AND)          \
+	X(BITWISE_OR)           \
+	X(BITWISE_XOR)          \
+	X(BITWISE_NOT)          \
+	X(RAND)                 \
+	X(GET_UNIT_VALUE)       \
+	X(GET)                  \
+	X(SET_LESS)             \
+	X(SET_LESS_OR_EQUAL)    \
+	X(SET_GREATER)          \
+	X(SET_GREATER_OR_EQUAL) \
+	X(SET_EQUAL)            \
+	X(SET_NOT_EQUAL)        \
+	X(LOGICAL_AND)          \
+	X(LOGICAL_OR)           \
+	X(LOGICAL_XOR)          \
+	X(LOGICAL_NOT)          \
+	X(START)                \
+	X(REAL_CALL)            \
+	X(LUA_CALL)             \
+	X(JUMP)                 \
+	X(RETURN)               \
+	X(JUMP_NOT_EQUAL)       \
+	X(SIGNAL)               \
+	X(SET_SIGNAL_MASK)      \
+	X(EXPLODE)              \
+	X(PLAY_SOUND)           \
+	X(SET)                  \
+	X(ATTACH)               \
+	X(DROP)                 \
+	/* SHADE, CACHE, START or CALL of empty functions, PUSH_STATIC out of range */ \
+	X(NOP)                  \
+	/* no valid opcode at this address, a holds the raw value */ \
+	X(UNKNOWN)              \
+	/* operands run past the end of the code */ \
+	X(TRUNCATED)
+
+
+/**
+ * One pre-decoded COB instruction. CCobFile decodes an instruction at every
+ * word offset of its code, so the program counter (and every saved return
+ * address or jump target) keeps indexing raw code words; len is the number
+ * of words (opcode plus operands) to advance past it.
+ */
+struct CobInstruction {
+	enum Op: uint8_t {
+		#define COB_INSTRUCTION_ENUM(name) OP_##name,
+		COB_INSTRUCTION_LIST(COB_INSTRUCTION_ENUM)
+		#undef COB_INSTRUCTION_ENUM
+		OP_COUNT
+	};
+
+	uint8_t op = OP_UNKNOWN;
+	uint8_t len = 1;
+
+	int a = 0;
+	int b = 0;
+};
+
+#endif // COB_INSTRUCTIONS_H
@@ -10,6 +10,8 @@
 
 #include "System/Misc/TracyDefs.h"
 
+#include <stdexcept>
+
 CR_BIND(CCobThread, )
 
 CR_REG_METADATA(CCobThread, (
@@ -226,86 +228,6 @@ void CCobThread::InitStack(unsigned int n, CCobThread* t)
 
 
 
-// Command documentation from http://visualta.tauniverse.com/Downloads/cob-commands.txt
-// And some information from basm0.8 source (basm ops.txt)
-
-// Model interaction
-static constexpr int MOVE       = 0x10001000;
-static constexpr int TURN       = 0x10002000;
-static constexpr int SPIN       = 0x10003000;
-static constexpr int STOP_SPIN  = 0x10004000;
-static constexpr int SHOW       = 0x10005000;
-static constexpr int HIDE       = 0x10006000;
-static constexpr int CACHE      = 0x10007000;
-static constexpr int DONT_CACHE = 0x10008000;
-static constexpr int MOVE_NOW   = 0x1000B000;
-static constexpr int TURN_NOW   = 0x1000C000;
-static constexpr int SHADE      = 0x1000D000;
-static constexpr int DONT_SHADE = 0x1000E000;
-static constexpr int EMIT_SFX   = 0x1000F000;
-
-// Blocking operations
-static constexpr int WAIT_TURN  = 0x10011000;
-static constexpr int WAIT_MOVE  = 0x10012000;
-static constexpr int SLEEP      = 0x10013000;
-
-// Stack manipulation
-static constexpr int PUSH_CONSTANT    = 0x10021001;
-static constexpr int PUSH_LOCAL_VAR   = 0x10021002;
-static constexpr int PUSH_STATIC      = 0x10021004;
-static constexpr int CREATE_LOCAL_VAR = 0x10022000;
-static constexpr int POP_LOCAL_VAR    = 0x10023002;
-static constexpr int POP_STATIC       = 0x10023004;
-static constexpr int POP_STACK        = 0x10024000; ///< Not sure what this is supposed to do
-
-// Arithmetic operations
-static constexpr int ADD         = 0x10031000;
-static constexpr int SUB         = 0x10032000;
-static constexpr int MUL         = 0x10033000;
-static constexpr int DIV         = 0x10034000;
-static constexpr int MOD		  = 0x10034001; ///< spring specific
-static constexpr int BITWISE_AND = 0x10035000;
-static constexpr int BITWISE_OR  = 0x10036000;
-static constexpr int BITWISE_XOR = 0x10037000;
-static constexpr int BITWISE_NOT = 0x10038000;
-
-// Native function calls
-static constexpr int RAND           = 0x10041000;
-static constexpr int GET_UNIT_VALUE = 0x10042000;
-static constexpr int GET            = 0x10043000;
-
-// Comparison
-static constexpr int SET_LESS             = 0x10051000;
-static constexpr int SET_LESS_OR_EQUAL    = 0x10052000;
-static constexpr int SET_GREATER          = 0x10053000;
-static constexpr int SET_GREATER_OR_EQUAL = 0x10054000;
-static constexpr int SET_EQUAL            = 0x10055000;
-static constexpr int SET_NOT_EQUAL        = 0x10056000;
-static constexpr int LOGICAL_AND          = 0x10057000;
-static constexpr int LOGICAL_OR           = 0x10058000;
-static constexpr int LOGICAL_XOR          = 0x10059000;
-static constexpr int LOGICAL_NOT          = 0x1005A000;
-
-// Flow control
-static constexpr int START           = 0x10061000;
-static constexpr int CALL            = 0x10062000; ///< converted when executed
-static constexpr int REAL_CALL       = 0x10062001; ///< spring custom
-static constexpr int LUA_CALL        = 0x10062002; ///< spring custom
-static constexpr int JUMP            = 0x10064000;
-static constexpr int RETURN          = 0x10065000;
-static constexpr int JUMP_NOT_EQUAL  = 0x10066000;
-static constexpr int SIGNAL          = 0x10067000;
-static constexpr int SET_SIGNAL_MASK = 0x10068000;
-
-// Piece destruction
-static constexpr int EXPLODE    = 0x10071000;
-static constexpr int PLAY_SOUND = 0x10072000;
-
-// Special functions
-static constexpr int SET    = 0x10082000;
-static constexpr int ATTACH = 0x10083000;
-static constexpr int DROP   = 0x10084000;
-
 // Indices for SET, GET, and GET_UNIT_VALUE for LUA return values
 static constexpr int LUA0 = 110; // (LUA0 returns the lua call status, 0 or 1)
 static constexpr int LUA1 = 111;
@@ -318,17 +240,12 @@ static constexpr int LUA7 = 117;
 static constexpr int LUA8 = 118;
 static constexpr int LUA9 = 119;
 
-#if 0
-#define GET_LONG_PC() (cobFile->code[pc++])
-#else
-// mantis #5981
-#define GET_LONG_PC() (cobFile->code.at(pc++))
-#endif
-
 
 #if 0
 static const char* GetOpcodeName(int opcode)
 {
+	using namespace CobOpcodes;
+
 	switch (opcode) {
 		case MOVE: return "move";
 		case TURN: return "turn";
@@ -404,6 +321,13 @@ static const char* GetOpcodeName(int opcode)
 #endif
 
 
+// computed goto is a GNU extension, everything else dispatches through a switch
+#if defined(__GNUC__)
+	#define COB_THREADED_DISPATCH 1
+#else
+	#define COB_THREADED_DISPATCH 0
+#endif
+
 bool CCobThread::Tick()
 {
 	assert(state != Sleep);
@@ -416,39 +340,72 @@ bool CCobThread::Tick()
 
 	state = Run;
 
+	const CobInstruction* instructions = cobFile->instructions.data();
+	const CobInstruction* ins = nullptr;
+
+	const size_t numInstructions = cobFile->instructions.size();
+
+	// the member would have to be reloaded after every call out of the loop,
+	// so dispatch runs on a local copy and only writes it back to pc
+	int nextPC = pc;
 	int r1, r2, r3, r4, r5, r6;
 
+	// pc keeps addressing raw code words; it is advanced past the operands
+	// before the instruction executes, exactly as the word-by-word decoder
+	// used to leave it (return addresses and error messages rely on this)
+	#define COB_FETCH()                                                          \
+		if (static_cast<size_t>(nextPC) >= numInstructions)                      \
+			throw std::out_of_range("[COBThread::Tick] pc out of range");       \
+		ins = &instructions[nextPC];                                             \
+		pc = (nextPC += ins->len);
+
+	#if COB_THREADED_DISPATCH
+	static const void* const dispatchTable[CobInstruction::OP_COUNT] = {
+		#define COB_DISPATCH_LABEL(name) &&op_##name,
+		COB_INSTRUCTION_LIST(COB_DISPATCH_LABEL)
+		#undef COB_DISPATCH_LABEL
+	};
+
+	#define COB_OP(name) op_##name:
+	#define COB_NEXT()                  \
+		if (state != Run)               \
+			goto done;                  \
+		COB_FETCH()                     \
+		goto *dispatchTable[ins->op];
+
+	COB_NEXT()
+	{
+	#else
+	#define COB_OP(name) case CobInstruction::OP_##name:
+	#define COB_NEXT() break;
+
 	while (state == Run) {
-		const int opcode = GET_LONG_PC();
-
-		switch (opcode) {
-			case PUSH_CONSTANT: {
-				r1 = GET_LONG_PC();
-				PushDataStack(r1);
-			} break;
-			case SLEEP: {
+		COB_FETCH()
+
+		switch (ins->op) {
+	#endif
+			COB_OP(PUSH_CONSTANT) {
+				PushDataStack(ins->a);
+			} COB_NEXT()
+			COB_OP(SLEEP) {
 				r1 = PopDataStack();
 				wakeTime = cobEngine->GetCurrTime() + r1;
 				state = Sleep;
 
 				cobEngine->ScheduleThread(this);
 				return true;
-			} break;
-			case SPIN: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+			}
+			COB_OP(SPIN) {
 				r3 = PopDataStack();         // speed
 				r4 = PopDataStack();         // accel
-				cobInst->Spin(r1, r2, r3, r4);
-			} break;
-			case STOP_SPIN: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+				cobInst->Spin(ins->a, ins->b, r3, r4);
+			} COB_NEXT()
+			COB_OP(STOP_SPIN) {
 				r3 = PopDataStack();         // decel
 
-				cobInst->StopSpin(r1, r2, r3);
-			} break;
-			case RETURN: {
+				cobInst->StopSpin(ins->a, ins->b, r3);
+			} COB_NEXT()
+			COB_OP(RETURN) {
 				retCode = PopDataStack();
 
 				if (LocalReturnAddr() == -1) {
@@ -460,281 +417,228 @@ bool CCobThread::Tick()
 				}
 
 				// return to caller
-				pc = LocalReturnAddr();
+				pc = nextPC = LocalReturnAddr();
 				if (dataStack.size() > LocalStackFrame())
 					dataStack.resize(LocalStackFrame());
 
 				callStack.pop_back();
-			} break;
-
-
-			case SHADE: {
-				r1 = GET_LONG_PC();
-			} break;
-			case DONT_SHADE: {
-				r1 = GET_LONG_PC();
-			} break;
-			case CACHE: {
-				r1 = GET_LONG_PC();
-			} break;
-			case DONT_CACHE: {
-				r1 = GET_LONG_PC();
-			} break;
-
-
-			case CALL: {
-				r1 = GET_LONG_PC();
-				pc--;
-
-				if (cobFile->scriptNames[r1].find("lua_") == 0) {
-					cobFile->code[pc - 1] = LUA_CALL;
-					LuaCall();
-					break;
-				}
+			} COB_NEXT()
 
-				cobFile->code[pc - 1] = REAL_CALL;
 
-				// fall-through
-			}
-			case REAL_CALL: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+			COB_OP(NOP) {
+			} COB_NEXT()
 
-				// do not call zero-length functions
-				if (cobFile->scriptLengths[r1] == 0)
-					break;
 
+			COB_OP(REAL_CALL) {
 				CallInfo& ci = PushCallStackRef();
-				ci.functionId = r1;
-				ci.returnAddr = pc;
-				ci.stackTop = dataStack.size() - r2;
+				ci.functionId = ins->a;
+				ci.returnAddr = nextPC;
+				ci.stackTop = dataStack.size() - ins->b;
 
-				paramCount = r2;
+				paramCount = ins->b;
 
-				// call cobFile->scriptNames[r1]
-				pc = cobFile->scriptOffsets[r1];
-			} break;
-			case LUA_CALL: {
-				LuaCall();
-			} break;
+				// call cobFile->scriptNames[ins->a]
+				pc = nextPC = cobFile->scriptOffsets[ins->a];
+			} COB_NEXT()
+			COB_OP(LUA_CALL) {
+				LuaCall(ins->a, ins->b);
+			} COB_NEXT()
 
 
-			case POP_STATIC: {
-				r1 = GET_LONG_PC();
-				r2 = PopDataStack();
-
-				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
-					cobInst->staticVars[r1] = r2;
-			} break;
-			case POP_STACK: {
+			COB_OP(POP_STATIC) {
+				cobInst->staticVars[ins->a] = PopDataStack();
+			} COB_NEXT()
+			COB_OP(POP_STACK) {
 				PopDataStack();
-			} break;
-
-
-			case START: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
-
-				if (cobFile->scriptLengths[r1] == 0)
-					break;
+			} COB_NEXT()
 
 
+			COB_OP(START) {
 				CCobThread t(cobInst);
 
 				t.SetID(cobEngine->GenThreadID());
-				t.InitStack(r2, this);
-				t.Start(r1, signalMask, {{0}}, true);
+				t.InitStack(ins->b, this);
+				t.Start(ins->a, signalMask, {{0}}, true);
 
 				// calling AddThread directly might move <this>, defer it
 				cobEngine->QueueAddThread(std::move(t));
-			} break;
+			} COB_NEXT()
 
-			case CREATE_LOCAL_VAR: {
+			COB_OP(CREATE_LOCAL_VAR) {
 				if (paramCount == 0) {
 					PushDataStack(0);
 				} else {
 					paramCount--;
 				}
-			} break;
-			case GET_UNIT_VALUE: {
+			} COB_NEXT()
+			COB_OP(GET_UNIT_VALUE) {
 				r1 = PopDataStack();
+
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+				} else {
+					PushDataStack(cobInst->GetUnitVal(r1, 0, 0, 0, 0));
 				}
-				r1 = cobInst->GetUnitVal(r1, 0, 0, 0, 0);
-				PushDataStack(r1);
-			} break;
+			} COB_NEXT()
 
 
-			case JUMP_NOT_EQUAL: {
-				r1 = GET_LONG_PC();
+			COB_OP(JUMP_NOT_EQUAL) {
 				r2 = PopDataStack();
 
 				if (r2 == 0)
-					pc = r1;
+					pc = nextPC = ins->a;
 
-			} break;
-			case JUMP: {
-				r1 = GET_LONG_PC();
+			} COB_NEXT()
+			COB_OP(JUMP) {
 				// this seem to be an error in the docs..
-				//r2 = cobFile->scriptOffsets[LocalFunctionID()] + r1;
-				pc = r1;
-			} break;
+				//r2 = cobFile->scriptOffsets[LocalFunctionID()] + ins->a;
+				pc = nextPC = ins->a;
+			} COB_NEXT()
 
 
-			case POP_LOCAL_VAR: {
-				r1 = GET_LONG_PC();
+			COB_OP(POP_LOCAL_VAR) {
 				r2 = PopDataStack();
-				dataStack[LocalStackFrame() + r1] = r2;
-			} break;
-			case PUSH_LOCAL_VAR: {
-				r1 = GET_LONG_PC();
-				r2 = dataStack[LocalStackFrame() + r1];
+				dataStack[LocalStackFrame() + ins->a] = r2;
+			} COB_NEXT()
+			COB_OP(PUSH_LOCAL_VAR) {
+				r2 = dataStack[LocalStackFrame() + ins->a];
 				PushDataStack(r2);
-			} break;
+			} COB_NEXT()
 
 
-			case BITWISE_AND: {
+			COB_OP(BITWISE_AND) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 & r2);
-			} break;
-			case BITWISE_OR: {
+			} COB_NEXT()
+			COB_OP(BITWISE_OR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 | r2);
-			} break;
-			case BITWISE_XOR: {
+			} COB_NEXT()
+			COB_OP(BITWISE_XOR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 ^ r2);
-			} break;
-			case BITWISE_NOT: {
+			} COB_NEXT()
+			COB_OP(BITWISE_NOT) {
 				r1 = PopDataStack();
 				PushDataStack(~r1);
-			} break;
+			} COB_NEXT()
 
-			case EXPLODE: {
-				r1 = GET_LONG_PC();
+			COB_OP(EXPLODE) {
 				r2 = PopDataStack();
-				cobInst->Explode(r1, r2);
-			} break;
+				cobInst->Explode(ins->a, r2);
+			} COB_NEXT()
 
-			case PLAY_SOUND: {
-				r1 = GET_LONG_PC();
+			COB_OP(PLAY_SOUND) {
 				r2 = PopDataStack();
-				cobInst->PlayUnitSound(r1, r2);
-			} break;
-
-			case PUSH_STATIC: {
-				r1 = GET_LONG_PC();
+				cobInst->PlayUnitSound(ins->a, r2);
+			} COB_NEXT()
 
-				if (static_cast<size_t>(r1) < cobInst->staticVars.size())
-					PushDataStack(cobInst->staticVars[r1]);
-			} break;
+			COB_OP(PUSH_STATIC) {
+				PushDataStack(cobInst->staticVars[ins->a]);
+			} COB_NEXT()
 
-			case SET_NOT_EQUAL: {
+			COB_OP(SET_NOT_EQUAL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 != r2));
-			} break;
-			case SET_EQUAL: {
+			} COB_NEXT()
+			COB_OP(SET_EQUAL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 
 				PushDataStack(int(r1 == r2));
-			} break;
+			} COB_NEXT()
 
-			case SET_LESS: {
+			COB_OP(SET_LESS) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 < r2));
-			} break;
-			case SET_LESS_OR_EQUAL: {
+			} COB_NEXT()
+			COB_OP(SET_LESS_OR_EQUAL) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 <= r2));
-			} break;
+			} COB_NEXT()
 
-			case SET_GREATER: {
+			COB_OP(SET_GREATER) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 > r2));
-			} break;
-			case SET_GREATER_OR_EQUAL: {
+			} COB_NEXT()
+			COB_OP(SET_GREATER_OR_EQUAL) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				PushDataStack(int(r1 >= r2));
-			} break;
+			} COB_NEXT()
 
-			case RAND: {
+			COB_OP(RAND) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = gsRNG.NextInt(r2 - r1 + 1) + r1;
 				PushDataStack(r3);
-			} break;
-			case EMIT_SFX: {
+			} COB_NEXT()
+			COB_OP(EMIT_SFX) {
 				r1 = PopDataStack();
-				r2 = GET_LONG_PC();
-				cobInst->EmitSfx(r1, r2);
-			} break;
-			case MUL: {
+				cobInst->EmitSfx(r1, ins->a);
+			} COB_NEXT()
+			COB_OP(MUL) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(r1 * r2);
-			} break;
+			} COB_NEXT()
 
 
-			case SIGNAL: {
+			COB_OP(SIGNAL) {
 				r1 = PopDataStack();
 				cobInst->Signal(r1);
-			} break;
-			case SET_SIGNAL_MASK: {
+			} COB_NEXT()
+			COB_OP(SET_SIGNAL_MASK) {
 				r1 = PopDataStack();
 				signalMask = r1;
-			} break;
+			} COB_NEXT()
 
 
-			case TURN: {
+			COB_OP(TURN) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
-				r3 = GET_LONG_PC(); // piece
-				r4 = GET_LONG_PC(); // axis
 
-				cobInst->Turn(r3, r4, r1, r2);
-			} break;
-			case GET: {
+				cobInst->Turn(ins->a, ins->b, r1, r2);
+			} COB_NEXT()
+			COB_OP(GET) {
 				r5 = PopDataStack();
 				r4 = PopDataStack();
 				r3 = PopDataStack();
 				r2 = PopDataStack();
 				r1 = PopDataStack();
+
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					PushDataStack(luaArgs[r1 - LUA0]);
-					break;
+				} else {
+					r6 = cobInst->GetUnitVal(r1, r2, r3, r4, r5);
+					PushDataStack(r6);
 				}
-				r6 = cobInst->GetUnitVal(r1, r2, r3, r4, r5);
-				PushDataStack(r6);
-			} break;
-			case ADD: {
+			} COB_NEXT()
+			COB_OP(ADD) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				PushDataStack(r1 + r2);
-			} break;
-			case SUB: {
+			} COB_NEXT()
+			COB_OP(SUB) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				r3 = r1 - r2;
 				PushDataStack(r3);
-			} break;
+			} COB_NEXT()
 
-			case DIV: {
+			COB_OP(DIV) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -745,8 +649,8 @@ bool CCobThread::Tick()
 					ShowError("division by zero");
 				}
 				PushDataStack(r3);
-			} break;
-			case MOD: {
+			} COB_NEXT()
+			COB_OP(MOD) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
@@ -756,140 +660,125 @@ bool CCobThread::Tick()
 					PushDataStack(0);
 					ShowError("modulo division by zero");
 				}
-			} break;
+			} COB_NEXT()
 
 
-			case MOVE: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+			COB_OP(MOVE) {
 				r4 = PopDataStack();
 				r3 = PopDataStack();
-				cobInst->Move(r1, r2, r3, r4);
-			} break;
-			case MOVE_NOW: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+				cobInst->Move(ins->a, ins->b, r3, r4);
+			} COB_NEXT()
+			COB_OP(MOVE_NOW) {
 				r3 = PopDataStack();
-				cobInst->MoveNow(r1, r2, r3);
-			} break;
-			case TURN_NOW: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
+				cobInst->MoveNow(ins->a, ins->b, r3);
+			} COB_NEXT()
+			COB_OP(TURN_NOW) {
 				r3 = PopDataStack();
-				cobInst->TurnNow(r1, r2, r3);
-			} break;
+				cobInst->TurnNow(ins->a, ins->b, r3);
+			} COB_NEXT()
 
 
-			case WAIT_TURN: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
-
-				if (cobInst->NeedsWait(CCobInstance::ATurn, r1, r2)) {
+			COB_OP(WAIT_TURN) {
+				if (cobInst->NeedsWait(CCobInstance::ATurn, ins->a, ins->b)) {
 					state = WaitTurn;
-					waitPiece = r1;
-					waitAxis = r2;
+					waitPiece = ins->a;
+					waitAxis = ins->b;
 					return true;
 				}
-			} break;
-			case WAIT_MOVE: {
-				r1 = GET_LONG_PC();
-				r2 = GET_LONG_PC();
-
-				if (cobInst->NeedsWait(CCobInstance::AMove, r1, r2)) {
+			} COB_NEXT()
+			COB_OP(WAIT_MOVE) {
+				if (cobInst->NeedsWait(CCobInstance::AMove, ins->a, ins->b)) {
 					state = WaitMove;
-					waitPiece = r1;
-					waitAxis = r2;
+					waitPiece = ins->a;
+					waitAxis = ins->b;
 					return true;
 				}
-			} break;
+			} COB_NEXT()
 
 
-			case SET: {
+			COB_OP(SET) {
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 
 				if ((r1 >= LUA0) && (r1 <= LUA9)) {
 					luaArgs[r1 - LUA0] = r2;
-					break;
+				} else {
+					cobInst->SetUnitVal(r1, r2);
 				}
+			} COB_NEXT()
 
-				cobInst->SetUnitVal(r1, r2);
-			} break;
 
-
-			case ATTACH: {
+			COB_OP(ATTACH) {
 				r3 = PopDataStack();
 				r2 = PopDataStack();
 				r1 = PopDataStack();
 				cobInst->AttachUnit(r2, r1);
-			} break;
-			case DROP: {
+			} COB_NEXT()
+			COB_OP(DROP) {
 				r1 = PopDataStack();
 				cobInst->DropUnit(r1);
-			} break;
+			} COB_NEXT()
 
 			// like bitwise ops, but only on values 1 and 0
-			case LOGICAL_NOT: {
+			COB_OP(LOGICAL_NOT) {
 				r1 = PopDataStack();
 				PushDataStack(int(r1 == 0));
-			} break;
-			case LOGICAL_AND: {
+			} COB_NEXT()
+			COB_OP(LOGICAL_AND) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 && r2));
-			} break;
-			case LOGICAL_OR: {
+			} COB_NEXT()
+			COB_OP(LOGICAL_OR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int(r1 || r2));
-			} break;
-			case LOGICAL_XOR: {
+			} COB_NEXT()
+			COB_OP(LOGICAL_XOR) {
 				r1 = PopDataStack();
 				r2 = PopDataStack();
 				PushDataStack(int((!!r1) ^ (!!r2)));
-			} break;
-
+			} COB_NEXT()
 
-			case HIDE: {
-				r1 = GET_LONG_PC();
-				cobInst->SetVisibility(r1, false);
-			} break;
 
-			case SHOW: {
-				r1 = GET_LONG_PC();
-
-				int i;
-				for (i = 0; i < MAX_WEAPONS_PER_UNIT; ++i)
-					if (LocalFunctionID() == cobFile->scriptIndex[COBFN_FirePrimary + COBFN_Weapon_Funcs * i])
-						break;
+			COB_OP(HIDE) {
+				cobInst->SetVisibility(ins->a, false);
+			} COB_NEXT()
 
+			COB_OP(SHOW) {
 				// if true, we are in a Fire-script and should show a special flare effect
-				if (i < MAX_WEAPONS_PER_UNIT) {
-					cobInst->ShowFlare(r1);
+				if (cobFile->IsFireScript(LocalFunctionID())) {
+					cobInst->ShowFlare(ins->a);
 				} else {
-					cobInst->SetVisibility(r1, true);
+					cobInst->SetVisibility(ins->a, true);
 				}
-			} break;
+			} COB_NEXT()
+
+			COB_OP(TRUNCATED) {
+				throw std::out_of_range("[COBThread::Tick] operands past end of code");
+			}
 
-			default: {
+			COB_OP(UNKNOWN) {
 				const char* name = cobFile->name.c_str();
 				const char* func = cobFile->scriptNames[LocalFunctionID()].c_str();
 
-				LOG_L(L_ERROR, "[COBThread::%s] unknown opcode %x (in %s:%s at %x)", __func__, opcode, name, func, pc - 1);
-
-				#if 0
-				auto ei = execTrace.begin();
-				while (ei != execTrace.end()) {
-					LOG_L(L_ERROR, "\tprogctr: %3x  opcode: %s", __func__, *ei, GetOpcodeName(cobFile->code[*ei]));
-					++ei;
-				}
-				#endif
+				LOG_L(L_ERROR, "[COBThread::%s] unknown opcode %x (in %s:%s at %x)", __func__, ins->a, name, func, pc - 1);
 
 				state = Dead;
 				return false;
-			} break;
+			}
+	#if COB_THREADED_DISPATCH
+	}
+
+done:
+	#else
 		}
 	}
+	#endif
+
+	#undef COB_NEXT
+	#undef COB_OP
+	#undef COB_FETCH
 
 	// can arrive here as dead, through CCobInstance::Signal()
 	return (state != Dead);
@@ -913,26 +802,23 @@ void CCobThread::ShowError(const char* msg)
 }
 
 
-void CCobThread::LuaCall()
+void CCobThread::LuaCall(int scriptId, int numArgs)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	const int r1 = GET_LONG_PC(); // script id
-	const int r2 = GET_LONG_PC(); // arg count
-
 	// setup the parameter array
 	const int size = static_cast<int>(dataStack.size());
-	const int argCount = std::min(r2, MAX_LUA_COB_ARGS);
-	const int start = std::max(0, size - r2);
+	const int argCount = std::min(numArgs, MAX_LUA_COB_ARGS);
+	const int start = std::max(0, size - numArgs);
 	const int end = std::min(size, start + argCount);
 
 	for (int a = 0, i = start; i < end; i++) {
 		luaArgs[a++] = dataStack[i];
 	}
 
-	if (r2 >= size) {
+	if (numArgs >= size) {
 		dataStack.clear();
 	} else {
-		dataStack.resize(size - r2);
+		dataStack.resize(size - numArgs);
 	}
 
 	if (!luaRules) {
@@ -941,13 +827,13 @@ void CCobThread::LuaCall()
 	}
 
 	// check script index validity
-	if (static_cast<size_t>(r1) >= cobFile->luaScripts.size()) {
+	if (static_cast<size_t>(scriptId) >= cobFile->luaScripts.size()) {
 		luaArgs[0] = 0; // failure
 		return;
 	}
 
 	int argsCount = argCount;
-	luaRules->Cob2Lua(cobFile->luaScripts[r1], cobInst->GetUnit(), argsCount, luaArgs);
+	luaRules->Cob2Lua(cobFile->luaScripts[scriptId], cobInst->GetUnit(), argsCount, luaArgs);
 	retCode = luaArgs[0];
 }
 
@@ -14,12 +14,14 @@
 #include "Sim/Ecs/Registry.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/ModInfo.h"
+#include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/MoveTypes/Systems/GeneralMoveSystem.h"
 #include "Sim/MoveTypes/Systems/GroundMoveSystem.h"
 #include "Sim/MoveTypes/Systems/UnitTrapCheckSystem.h"
 #include "Sim/Path/IPathManager.h"
+#include "Sim/Weapons/HitScanBatch.h"
 #include "Sim/Weapons/Weapon.h"
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
@@ -443,9 +445,13 @@ void CUnitHandler::UpdateUnitWeapons()
 	}
 	{
 		SCOPED_TIMER("Sim::Unit::Weapon");
+		hitScanBatch.Begin();
+
 		for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
 			activeUnits[activeUpdateUnit]->UpdateWeapons();
 		}
+
+		hitScanBatch.End();
 	}
 }
 
@@ -456,6 +462,8 @@ void CUnitHandler::Update()
 
 	DeleteUnits();
 	UpdateUnitMoveTypes();
+	// weapons test their cones against these (TraceRay::Test*Cone)
+	quadField.UpdateObjectBounds();
 	QueueDeleteUnits();
 	UpdateUnitLosStates();
 	SlowUpdateUnits();
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "BeamLaser.h"
+#include "HitScanBatch.h"
 #include "PlasmaRepulser.h"
 #include "WeaponDef.h"
 #include "Game/GameHelper.h"
@@ -274,25 +275,8 @@ void CBeamLaser::FireImpl(const bool scriptCall)
 void CBeamLaser::FireInternal(float3 curDir)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	float actualRange = range;
 	float rangeMod = 1.0f - (0.05f * owner->UnderFirstPersonControl());
-
-	bool tryAgain = true;
-	bool doDamage = true;
-
 	float maxLength = range * rangeMod;
-	float curLength = 0.0f;
-
-	float3 curPos = weaponMuzzlePos;
-	float3 hitPos;
-	float3 newDir;
-
-	// objects at the end of the beam
-	CUnit* hitUnit = nullptr;
-	CFeature* hitFeature = nullptr;
-	CPlasmaRepulser* hitShield = nullptr;
-	static std::vector<TraceRay::SShieldDist> hitShields;
-	CollisionQuery hitColQuery;
 
 	if (!sweepFireState.IsSweepFiring()) {
 		curDir += (gsRNG.NextVector() * SprayAngleExperience());
@@ -315,11 +299,63 @@ void CBeamLaser::FireInternal(float3 curDir)
 		maxLength = std::min(maxLength, sweepFireState.GetTargetDist3D() * 1.125f);
 	}
 
+	HitScanShot shot;
+	shot.weapon = this;
+	shot.pos = weaponMuzzlePos;
+	shot.dir = curDir;
+	shot.length = maxLength;
+	shot.damageMult = salvoDamageMult;
+	shot.traceFlags = collisionFlags;
+	shot.sweepFire = sweepFireState.IsSweepFiring();
+
+	if (hitScanBatch.IsCollecting()) {
+		hitScanBatch.AddShot(shot);
+		return;
+	}
+
+	shot.hitLength = TraceRay::TraceRay(shot.pos, shot.dir, shot.length, shot.traceFlags, owner, shot.hitUnit, shot.hitFeature, &shot.hitColQuery);
+
+	FireHitScanShot(shot);
+}
+
+void CBeamLaser::FireHitScanShot(const HitScanShot& shot)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	float actualRange = range;
+
+	bool tryAgain = true;
+	bool doDamage = true;
+
+	float maxLength = shot.length;
+	float curLength = 0.0f;
+
+	float3 curPos = shot.pos;
+	float3 curDir = shot.dir;
+	float3 hitPos;
+	float3 newDir;
+
+	// objects at the end of the beam
+	CUnit* hitUnit = nullptr;
+	CFeature* hitFeature = nullptr;
+	CPlasmaRepulser* hitShield = nullptr;
+	static std::vector<TraceRay::SShieldDist> hitShields;
+	CollisionQuery hitColQuery;
+
 	for (int tries = 0; tries < 5 && tryAgain; ++tries) {
-		float beamLength = TraceRay::TraceRay(curPos, curDir, maxLength - curLength, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+		float beamLength = 0.0f;
+
+		// the first segment was traced by the caller (or the batch)
+		if (tries == 0) {
+			beamLength = shot.hitLength;
+			hitUnit = shot.hitUnit;
+			hitFeature = shot.hitFeature;
+			hitColQuery = shot.hitColQuery;
+		} else {
+			beamLength = TraceRay::TraceRay(curPos, curDir, maxLength - curLength, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+		}
 
 		if (hitUnit != nullptr && teamHandler.AlliedTeams(hitUnit->team, owner->team)) {
-			if (sweepFireState.IsSweepFiring() && !sweepFireState.DamageAllies()) {
+			if (shot.sweepFire && !sweepFireState.DamageAllies()) {
 				doDamage = false; break;
 			}
 		}
@@ -342,7 +378,7 @@ void CBeamLaser::FireInternal(float3 curDir)
 		TraceRay::TraceRayShields(this, curPos, curDir, beamLength, hitShields);
 
 		for (const TraceRay::SShieldDist& sd: hitShields) {
-			if (sd.dist < beamLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), salvoDamageMult)) {
+			if (sd.dist < beamLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), shot.damageMult)) {
 				beamLength = sd.dist;
 
 				hitUnit = nullptr;
@@ -400,8 +436,8 @@ void CBeamLaser::FireInternal(float3 curDir)
 		// make it possible to always hit with some minimal intensity (melee weapons have use for that)
 		const float hitIntensity = std::max(weaponDef->minIntensity, 1.0f - curLength / (actualRange * 2.0f));
 
-		const DamageArray& baseDamages = damages->GetDynamicDamages(weaponMuzzlePos, curPos);
-		const DamageArray da = baseDamages * (hitIntensity * salvoDamageMult);
+		const DamageArray& baseDamages = damages->GetDynamicDamages(shot.pos, curPos);
+		const DamageArray da = baseDamages * (hitIntensity * shot.damageMult);
 		const CExplosionParams params = {
 			.pos                  = hitPos,
 			.dir                  = curDir,
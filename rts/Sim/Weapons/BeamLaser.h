@@ -15,6 +15,7 @@ public:
 
 	void Update() override final;
 	void Init() override final;
+	void FireHitScanShot(const HitScanShot& shot) override final;
 
 private:
 	float3 GetFireDir(bool sweepFire, bool scriptCall);
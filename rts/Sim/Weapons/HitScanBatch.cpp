@@ -0,0 +1,117 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "HitScanBatch.h"
+#include "Weapon.h"
+#include "Game/TraceRay.h"
+#include "Rendering/Models/3DModel.h"
+#include "Sim/Features/Feature.h"
+#include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
+#include "Sim/Misc/QuadField.h"
+#include "Sim/Units/Unit.h"
+#include "System/Threading/ThreadPool.h"
+
+#include "System/Misc/TracyDefs.h"
+
+CHitScanBatch hitScanBatch;
+
+
+// piece matrices and the piece BVH of a model are updated lazily on
+// first access, which must not happen concurrently from several traces
+static void PrepareTraceObject(CSolidObject* o, int tempNum)
+{
+	if (o->tempNum == tempNum)
+		return;
+
+	o->tempNum = tempNum;
+
+	if (!o->collisionVolume.DefaultToPieceTree())
+		return;
+	if (!o->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
+		return;
+
+	const LocalModel& lm = o->localModel;
+
+	for (unsigned int n = 0; n < lm.pieces.size(); n++) {
+		lm.GetPiece(n)->GetModelSpaceMatrix();
+	}
+
+	lm.GetPieceBVH();
+}
+
+
+void CHitScanBatch::Begin()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	assert(!collecting);
+	assert(shots.empty());
+
+	collecting = modInfo.batchHitScanTraces;
+}
+
+void CHitScanBatch::End()
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	if (!collecting)
+		return;
+
+	collecting = false;
+
+	if (shots.empty())
+		return;
+
+	PrepareTraces();
+	ResolveTraces();
+	ApplyShots();
+}
+
+
+void CHitScanBatch::PrepareTraces()
+{
+	ZoneScoped;
+	const int tempNum = gs->GetTempNum();
+
+	for (const HitScanShot& shot: shots) {
+		QuadFieldQuery qfQuery;
+		quadField.GetQuadsOnRay(qfQuery, shot.pos, shot.dir, shot.length);
+
+		for (const int quadIdx: *qfQuery.quads) {
+			const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
+
+			for (CUnit* u: quad.units) {
+				PrepareTraceObject(u, tempNum);
+			}
+			for (CFeature* f: quad.features) {
+				PrepareTraceObject(f, tempNum);
+			}
+		}
+	}
+}
+
+void CHitScanBatch::ResolveTraces()
+{
+	ZoneScoped;
+
+	// traces only read the world, each result depends on its own shot alone
+	for_mt(0, shots.size(), [&](const int i) {
+		HitScanShot& shot = shots[i];
+		shot.hitLength = TraceRay::TraceRay(shot.pos, shot.dir, shot.length, shot.traceFlags, shot.weapon->owner, shot.hitUnit, shot.hitFeature, &shot.hitColQuery);
+	});
+}
+
+void CHitScanBatch::ApplyShots()
+{
+	ZoneScoped;
+
+	// nothing is queued while applying (collecting is off), shots
+	// that are fired meanwhile (e.g. from Lua) are traced directly
+	for (const HitScanShot& shot: shots) {
+		// the owner was killed by a shot earlier in the batch
+		if (shot.weapon->owner->isDead)
+			continue;
+
+		shot.weapon->FireHitScanShot(shot);
+	}
+
+	shots.clear();
+}
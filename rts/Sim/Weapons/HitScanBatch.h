@@ -0,0 +1,68 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef HIT_SCAN_BATCH_H
+#define HIT_SCAN_BATCH_H
+
+#include <vector>
+
+#include "Sim/Misc/CollisionHandler.h"
+#include "System/float3.h"
+
+class CWeapon;
+class CUnit;
+class CFeature;
+
+// one instant (beam or lightning) shot, its first trace is resolved by the batch
+struct HitScanShot {
+	CWeapon* weapon = nullptr;
+
+	float3 pos;
+	float3 dir;
+	float3 tgtPos;
+
+	float length = 0.0f;
+	float damageMult = 1.0f;
+
+	int traceFlags = 0;
+
+	bool sweepFire = false;
+
+	// result of TraceRay(pos, dir, length, traceFlags)
+	CUnit* hitUnit = nullptr;
+	CFeature* hitFeature = nullptr;
+	CollisionQuery hitColQuery;
+
+	float hitLength = 0.0f;
+};
+
+/**
+ * Collects the traces of all hitscan shots fired during the weapon updates
+ * of a sim frame and resolves them in one batch: every trace runs in parallel
+ * against the state of the world after the updates, then the shots are
+ * finished (shields, reflections, damage) on the sim thread in the order
+ * they were fired. Only used when the batchHitScanTraces modrule is set.
+ */
+class CHitScanBatch {
+public:
+	void Begin();
+	void End();
+
+	bool IsCollecting() const { return collecting; }
+
+	void AddShot(const HitScanShot& shot) { shots.push_back(shot); }
+
+private:
+	void PrepareTraces();
+	void ResolveTraces();
+	void ApplyShots();
+
+private:
+	std::vector<HitScanShot> shots;
+
+	bool collecting = false;
+};
+
+extern CHitScanBatch hitScanBatch;
+
+#endif
+
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include "LightningCannon.h"
+#include "HitScanBatch.h"
 #include "PlasmaRepulser.h"
 #include "WeaponDef.h"
 #include "Game/GameHelper.h"
@@ -31,17 +32,39 @@ CLightningCannon::CLightningCannon(CUnit* owner, const WeaponDef* def): CWeapon(
 void CLightningCannon::FireImpl(const bool scriptCall)
 {
 	RECOIL_DETAILED_TRACY_ZONE;
-	float3 curPos = weaponMuzzlePos;
 	float3 curDir = (currentTargetPos - weaponMuzzlePos).SafeNormalize();
 
 	curDir += (gsRNG.NextVector() * SprayAngleExperience() + SalvoErrorExperience());
 	curDir.Normalize();
 
-	CUnit* hitUnit = nullptr;
-	CFeature* hitFeature = nullptr;
-	CollisionQuery hitColQuery;
+	HitScanShot shot;
+	shot.weapon = this;
+	shot.pos = weaponMuzzlePos;
+	shot.dir = curDir;
+	shot.tgtPos = currentTargetPos;
+	shot.length = range;
+	shot.traceFlags = collisionFlags;
+
+	if (hitScanBatch.IsCollecting()) {
+		hitScanBatch.AddShot(shot);
+		return;
+	}
+
+	shot.hitLength = TraceRay::TraceRay(shot.pos, shot.dir, shot.length, shot.traceFlags, owner, shot.hitUnit, shot.hitFeature, &shot.hitColQuery);
+
+	FireHitScanShot(shot);
+}
+
+void CLightningCannon::FireHitScanShot(const HitScanShot& shot)
+{
+	RECOIL_DETAILED_TRACY_ZONE;
+	const float3 curPos = shot.pos;
+	const float3 curDir = shot.dir;
+
+	CUnit* hitUnit = shot.hitUnit;
+	CFeature* hitFeature = shot.hitFeature;
 
-	float boltLength = TraceRay::TraceRay(curPos, curDir, range, collisionFlags, owner, hitUnit, hitFeature, &hitColQuery);
+	float boltLength = shot.hitLength;
 
 	if (!weaponDef->waterweapon) {
 		// terminate bolt at water surface if necessary
@@ -54,7 +77,7 @@ void CLightningCannon::FireImpl(const bool scriptCall)
 
 	static std::vector<TraceRay::SShieldDist> hitShields;
 	hitShields.clear();
-	TraceRay::TraceRayShields(this, curPos, curDir, range, hitShields);
+	TraceRay::TraceRayShields(this, curPos, curDir, shot.length, hitShields);
 	for (const TraceRay::SShieldDist& sd: hitShields) {
 		if (sd.dist < boltLength && sd.rep->IncomingBeam(this, curPos, curPos + (curDir * sd.dist), 1.0f)) {
 			boltLength = sd.dist;
@@ -65,10 +88,10 @@ void CLightningCannon::FireImpl(const bool scriptCall)
 	}
 
 	if (hitUnit != nullptr)
-		hitUnit->SetLastHitPiece(hitColQuery.GetHitPiece(), gs->frameNum);
+		hitUnit->SetLastHitPiece(shot.hitColQuery.GetHitPiece(), gs->frameNum);
 
 
-	const DamageArray& damageArray = damages->GetDynamicDamages(weaponMuzzlePos, currentTargetPos);
+	const DamageArray& damageArray = damages->GetDynamicDamages(shot.pos, shot.tgtPos);
 	const CExplosionParams params = {
 		.pos                  = curPos + curDir * boltLength,
 		.dir                  = curDir,
@@ -11,6 +11,8 @@ class CLightningCannon: public CWeapon
 public:
 	CLightningCannon(CUnit* owner = nullptr, const WeaponDef* def = nullptr);
 
+	void FireHitScanShot(const HitScanShot& shot) override final;
+
 private:
 	void FireImpl(const bool scriptCall) override final;
 	float GetPredictedImpactTime(float3 p) const override final { return 0.0f; }
@@ -15,6 +15,7 @@
 class CUnit;
 class CWeaponProjectile;
 struct WeaponDef;
+struct HitScanShot;
 
 
 class CWeapon : public CObject
@@ -95,6 +96,9 @@ public:
 	bool StopAttackingTargetIf(const std::function<bool(const SWeaponTarget&)>& pred);
 	bool StopAttackingAllyTeam(const int ally);
 
+	/// finishes an instant shot whose first trace was resolved by CHitScanBatch
+	virtual void FireHitScanShot(const HitScanShot& shot) {}
+
 	bool IsFastAutoRetargetingEnabled() const { return fastAutoRetargeting; }
 	void UpdateWeaponErrorVector();
 	void UpdateWeaponVectors();
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "System/float3.h"
+#include "System/creg/creg_cond.h"
 #include "System/Misc/SpringTime.h"
 
 #if defined(__APPLE__) || defined(__OpenBSD__)
@@ -40,6 +41,26 @@ class LuaMaterial;
 #endif
 
 
+// one queued UnitDamaged event, see CEventHandler::UnitDamagedBatch
+// (ids instead of pointers since the unit or its attacker can die
+// before the batch is delivered)
+struct UnitDamagedEvent {
+	CR_DECLARE_STRUCT(UnitDamagedEvent)
+
+	int unitID;
+	int unitDefID;
+	int unitTeam;
+	int weaponDefID;
+	int projectileID;
+	int attackerID;     // -1 if there was no attacker
+	int attackerDefID;  // -1 if there was no attacker
+	int attackerTeam;   // -1 if there was no attacker
+
+	float damage;
+	bool paralyzer;
+};
+
+
 enum DbgTimingInfoType {
 	TIMING_VIDEO,
 	TIMING_SIM,
@@ -143,6 +164,7 @@ class CEventClient
 			int weaponDefID,
 			int projectileID,
 			bool paralyzer) {}
+		virtual void UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events) {}
 		virtual void UnitStunned(const CUnit* unit, bool stunned) {}
 		virtual void UnitExperience(const CUnit* unit, float oldExperience) {}
 		virtual void UnitHarvestStorageFull(const CUnit* unit) {}
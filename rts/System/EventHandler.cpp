@@ -3,7 +3,9 @@
 #include "System/EventHandler.h"
 
 #include "Lua/LuaCallInCheck.h"
+#include "Lua/LuaGarbageCollectCtrl.h"
 #include "Lua/LuaOpenGL.h"  // FIXME -- should be moved
+#include "Sim/Units/UnitDef.h"
 
 #include "System/Config/ConfigHandler.h"
 #include "System/Platform/Threading.h"
@@ -14,6 +16,21 @@
 CEventHandler eventHandler;
 
 
+CR_BIND(UnitDamagedEvent, )
+CR_REG_METADATA(UnitDamagedEvent, (
+	CR_MEMBER(unitID),
+	CR_MEMBER(unitDefID),
+	CR_MEMBER(unitTeam),
+	CR_MEMBER(weaponDefID),
+	CR_MEMBER(projectileID),
+	CR_MEMBER(attackerID),
+	CR_MEMBER(attackerDefID),
+	CR_MEMBER(attackerTeam),
+	CR_MEMBER(damage),
+	CR_MEMBER(paralyzer)
+))
+
+
 /******************************************************************************/
 /******************************************************************************/
 
@@ -40,6 +57,9 @@ void CEventHandler::ResetState()
 	handles.clear();
 	handles.reserve(16);
 
+	unitDamagedEvents.clear();
+	unitDamagedEventsBatch.clear();
+
 	SetupEvents();
 }
 
@@ -446,6 +466,29 @@ bool CEventHandler::UnitPreDamaged(
 }
 
 
+void CEventHandler::QueueUnitDamaged(
+	const CUnit* unit,
+	const CUnit* attacker,
+	float damage,
+	int weaponDefID,
+	int projectileID,
+	bool paralyzer
+) {
+	UnitDamagedEvent& e = unitDamagedEvents.emplace_back();
+
+	e.unitID = unit->id;
+	e.unitDefID = unit->unitDef->id;
+	e.unitTeam = unit->team;
+	e.weaponDefID = weaponDefID;
+	e.projectileID = projectileID;
+	e.attackerID = (attacker != nullptr)? attacker->id: -1;
+	e.attackerDefID = (attacker != nullptr)? attacker->unitDef->id: -1;
+	e.attackerTeam = (attacker != nullptr)? attacker->team: -1;
+	e.damage = damage;
+	e.paralyzer = paralyzer;
+}
+
+
 bool CEventHandler::FeaturePreDamaged(
 	const CFeature* feature,
 	const CUnit* attacker,
@@ -561,6 +604,20 @@ void CEventHandler::GameFramePost(int gameFrame)
 	ITERATE_EVENTCLIENTLIST(GameFramePost, gameFrame);
 }
 
+void CEventHandler::UnitDamagedBatch()
+{
+	ZoneScoped;
+
+	if (unitDamagedEvents.empty())
+		return;
+
+	// damage dealt from within the call-in is queued for the next batch
+	unitDamagedEventsBatch.swap(unitDamagedEvents);
+	unitDamagedEvents.clear();
+
+	ITERATE_EVENTCLIENTLIST(UnitDamagedBatch, unitDamagedEventsBatch);
+}
+
 void CEventHandler::GameProgress(int gameFrame)
 {
 	ZoneScoped;
@@ -628,6 +685,10 @@ void CEventHandler::UnitHarvestStorageFull(const CUnit* unit)
 void CEventHandler::CollectGarbage(bool forced)
 {
 	ZoneScoped;
+
+	if (!forced)
+		luaGCSched.BeginRound(listCollectGarbage.size());
+
 	ITERATE_EVENTCLIENTLIST(CollectGarbage, forced);
 }
 
@@ -92,6 +92,10 @@ class CEventHandler
 			int weaponDefID,
 			int projectileID,
 			bool paralyzer);
+		/// delivers all UnitDamaged events queued since the last call
+		void UnitDamagedBatch();
+		/// events queued for the next UnitDamagedBatch, saved with the game
+		std::vector<UnitDamagedEvent>& GetQueuedUnitDamagedEvents() { return unitDamagedEvents; }
 		void UnitStunned(const CUnit* unit, bool stunned);
 		void UnitExperience(const CUnit* unit, float oldExperience);
 		void UnitHarvestStorageFull(const CUnit* unit);
@@ -349,9 +353,21 @@ class CEventHandler
 		void ListInsert(EventClientList& ciList, CEventClient* ec);
 		void ListRemove(EventClientList& ciList, CEventClient* ec);
 
+		void QueueUnitDamaged(
+			const CUnit* unit,
+			const CUnit* attacker,
+			float damage,
+			int weaponDefID,
+			int projectileID,
+			bool paralyzer);
+
 	private:
 		CEventClient* mouseOwner;
 
+		// only filled while some client wants UnitDamagedBatch
+		std::vector<UnitDamagedEvent> unitDamagedEvents;
+		std::vector<UnitDamagedEvent> unitDamagedEventsBatch;
+
 	private:
 		EventMap eventMap;
 
@@ -549,6 +565,9 @@ inline void CEventHandler::UnitDamaged(
 	bool paralyzer)
 {
 	ITERATE_UNIT_ALLYTEAM_EVENTCLIENTLIST(UnitDamaged, unit, attacker, damage, weaponDefID, projectileID, paralyzer)
+
+	if (!listUnitDamagedBatch.empty())
+		QueueUnitDamaged(unit, attacker, damage, weaponDefID, projectileID, paralyzer);
 }
 
 inline void CEventHandler::UnitStunned(
@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
 #include <sstream>
 #include <zlib.h>
 
@@ -47,6 +48,7 @@
 #include "System/Threading/ThreadPool.h"
 #include "System/creg/SerializeLuaState.h"
 #include "System/creg/Serializer.h"
+#include "System/EventHandler.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
 
@@ -110,6 +112,10 @@ void CGameStateCollector::Serialize(creg::ISerializer* s)
 	std::unique_ptr<creg::IType> mapType = creg::DeduceType<decltype(CSplitLuaHandle::gameParams)>::Get();
 	mapType->Serialize(s, &CSplitLuaHandle::gameParams);
 
+	// damage dealt outside of (or late in) a sim frame waits for the next UnitDamagedBatch
+	std::unique_ptr<creg::IType> dmgEventsType = creg::DeduceType<std::vector<UnitDamagedEvent>>::Get();
+	dmgEventsType->Serialize(s, &eventHandler.GetQueuedUnitDamagedEvents());
+
 	s->SerializeObjectInstance(CUnitDrawer::modelDrawerData->GetSavedData(), CUnitDrawer::modelDrawerData->GetSavedData()->GetClass());
 	//s->SerializeObjectInstance(groundDecals, groundDecals->GetClass());
 }
@@ -132,6 +138,7 @@ public:
 	std::vector<bool> watchProjectileDefs;  // callin masks for Projectile*
 	std::vector<bool> watchExplosionDefs;   // callin masks for Explosion
 	std::vector<bool> watchAllowTargetDefs; // callin masks for AllowWeapon*Target*
+	std::vector<std::vector<bool>> callInFilterMasks; // Script.SetCallInFilter masks, three per call-in
 	decltype(CLuaHandle::delayedCallsByFrame) delayedCallsByFrame;
 
 	void Serialize(creg::ISerializer* s);
@@ -147,6 +154,7 @@ CR_REG_METADATA(CLuaStateCollector, (
 	CR_MEMBER(watchProjectileDefs),
 	CR_MEMBER(watchExplosionDefs),
 	CR_MEMBER(watchAllowTargetDefs),
+	CR_MEMBER(callInFilterMasks),
 	CR_MEMBER(delayedCallsByFrame),
 	CR_SERIALIZER(Serialize)
 ))
@@ -164,6 +172,15 @@ void CLuaStateCollector::Read(const CSplitLuaHandle* handle) {
 	watchExplosionDefs = handle->syncedLuaHandle.watchExplosionDefs;
 	watchAllowTargetDefs = handle->syncedLuaHandle.watchAllowTargetDefs;
 
+	callInFilterMasks.clear();
+	callInFilterMasks.reserve(CLuaHandle::CALLIN_FILTER_COUNT * 3);
+
+	for (const auto& filter: handle->syncedLuaHandle.callInFilters) {
+		callInFilterMasks.push_back(filter.unitDefs);
+		callInFilterMasks.push_back(filter.teams);
+		callInFilterMasks.push_back(filter.weaponDefs);
+	}
+
 	/* This container only holds indexes to the Lua registry, which is
 	 * saved alongside the rest of the Lua state since it's fundamentally
 	 * just a regular Lua table. So just a shallow copy is sufficient. */
@@ -182,6 +199,14 @@ void CLuaStateCollector::Write(CSplitLuaHandle* handle) {
 	handle->syncedLuaHandle.watchProjectileDefs = watchProjectileDefs;
 	handle->syncedLuaHandle.watchExplosionDefs = watchExplosionDefs;
 	handle->syncedLuaHandle.watchAllowTargetDefs = watchAllowTargetDefs;
+
+	for (size_t i = 0, n = std::min(callInFilterMasks.size() / 3, handle->syncedLuaHandle.callInFilters.size()); i < n; i++) {
+		auto& filter = handle->syncedLuaHandle.callInFilters[i];
+
+		filter.unitDefs   = callInFilterMasks[i * 3 + 0];
+		filter.teams      = callInFilterMasks[i * 3 + 1];
+		filter.weaponDefs = callInFilterMasks[i * 3 + 2];
+	}
 	handle->syncedLuaHandle.delayedCallsByFrame = delayedCallsByFrame;
 }
 
@@ -260,6 +285,9 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 	selectedUnitsHandler.ClearSelected();
 
 	try {
+		// must stay seekable: SavePackage() patches its header in after
+		// the objects are written and LoadPackage() seeks to absolute
+		// offsets, so the gz sink can only be fed once everything is in
 		std::stringstream oss;
 
 		// write our own header. SavePackage() will add its own
@@ -310,7 +338,8 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 				return;
 			}
 
-			std::string data = oss.str();
+			// moves the buffer out instead of copying the whole savegame again
+			std::string data = std::move(oss).str();
 			std::function<void(gzFile, std::string&&)> func = [](gzFile file, std::string&& data) {
 				gzwrite(file, data.c_str(), data.size());
 				gzflush(file, Z_FINISH);
@@ -372,6 +372,315 @@ template<size_t N, class ...T>
 using StaticMemPoolT = StaticMemPool<N, sizeof(TypesMem<T...>), alignof(TypesMem<T...>)>;
 
 
+// size-class (slab) version
+// every allocation is served from the smallest of the page sizes <Sizes...>
+// that fits it rather than from a page sized for the largest type; each
+// class carves its pages out of its own contiguous chunks of K pages, so
+// objects of similar size are packed together and small ones do not pay
+// for the footprint of the biggest
+template<size_t K, size_t Alignment, size_t... Sizes> struct SizeClassMemPool {
+public:
+	template<typename T, typename... A> T* alloc(A&&... a) {
+		static_assert(sizeof(T) <= PAGE_SIZE(), "");
+		static_assert(Alignment >= alignof(T), "Memory pool memory is not sufficiently aligned");
+		return (new (allocMem(sizeof(T))) T(std::forward<A>(a)...));
+	}
+
+	void* allocMem(size_t size) {
+		const size_t sizeClass = SIZE_CLASS(size);
+
+		assert(sizeClass < NUM_CLASSES());
+
+		t_size_class& sc = classes[sizeClass];
+
+		if (sc.indcs.empty()) {
+			const size_t numChunks = sc.chunks.size();
+
+			// value-initialized: like every other pool, fresh pages must
+			// hand out zeroed memory (freeMem restores this on release)
+			sc.chunks.emplace_back(new t_block[K * PAGE_STRIDE(sizeClass) / sizeof(t_block)]());
+
+			// reserve new indices; in reverse order since each will be popped from the back
+			sc.indcs.reserve(K);
+
+			for (size_t j = 0; j < K; j++) {
+				sc.indcs.push_back(static_cast<uint32_t>((numChunks + 1) * K - j - 1));
+			}
+		}
+
+		const uint32_t idx = spring::VectorBackPop(sc.indcs);
+
+		t_page_header* page = page_header(sizeClass, idx);
+		page->index = idx;
+		page->sizeClass = static_cast<uint32_t>(sizeClass);
+
+		sc.numUsed += 1;
+		sc.peakUsed = std::max(sc.peakUsed, sc.numUsed);
+
+		usedSize += PAGE_SIZE(sizeClass);
+		peakSize = std::max(peakSize, usedSize);
+
+		void* m = page_data(page);
+
+		lastAlloc = m;
+		return m;
+	}
+
+
+	template<typename T> void free(T*& ptr) {
+		static_assert(sizeof(T) <= PAGE_SIZE(), "");
+
+		T* tmp = ptr;
+
+		spring::SafeDestruct(ptr);
+		// must free after dtor runs, see DynMemPool::free
+		freeMem(tmp);
+	}
+
+	void freeMem(void* ptr) {
+		assert(mapped(ptr));
+
+		const t_page_header* page = page_header_from_ptr(ptr);
+		const size_t sizeClass = page->sizeClass;
+
+		t_size_class& sc = classes[sizeClass];
+		sc.indcs.push_back(page->index);
+		sc.numUsed -= 1;
+
+		usedSize -= PAGE_SIZE(sizeClass);
+
+		std::memset(ptr, 0, PAGE_SIZE(sizeClass));
+	}
+
+	void reserve(size_t n) {
+		for (t_size_class& sc: classes) {
+			sc.indcs.reserve(n);
+		}
+	}
+	void clear() {
+		// for every allocated chunk, add back all indices
+		// (objects are assumed to have already been freed)
+		for (t_size_class& sc: classes) {
+			sc.indcs.clear();
+
+			for (size_t i = 0, n = sc.chunks.size(); i < n; i++) {
+				for (size_t j = 0; j < K; j++) {
+					sc.indcs.push_back(static_cast<uint32_t>((n - i) * K - j - 1));
+				}
+			}
+
+			sc.numUsed = 0;
+			sc.peakUsed = 0;
+		}
+
+		usedSize = 0;
+		peakSize = 0;
+		lastAlloc = nullptr;
+	}
+
+	static constexpr size_t NUM_CLASSES() { return (sizeof...(Sizes)); }
+	static constexpr size_t NUM_PAGES() { return K; } // per chunk
+	static constexpr size_t PAGE_SIZE(size_t sizeClass) { return PAGE_SIZES[sizeClass]; }
+	static constexpr size_t PAGE_SIZE() { return PAGE_SIZES[NUM_CLASSES() - 1]; } // largest class
+	static constexpr size_t SIZE_CLASS(size_t size) {
+		for (size_t i = 0; i < NUM_CLASSES(); i++) {
+			if (size <= PAGE_SIZES[i])
+				return i;
+		}
+
+		return NUM_CLASSES();
+	}
+
+	size_t alloc_size() const { // size of total number of pages added over the pool's lifetime
+		size_t sum = 0;
+
+		for (size_t i = 0; i < NUM_CLASSES(); i++) {
+			sum += (classes[i].chunks.size() * NUM_PAGES() * PAGE_SIZE(i));
+		}
+
+		return sum;
+	}
+	size_t freed_size() const { return (alloc_size() - usedSize); } // size of number of pages that were freed and are awaiting reuse
+	size_t used_size() const { return usedSize; }
+	size_t peak_size() const { return peakSize; } // highest used_size since the last clear
+
+	size_t num_pages(size_t sizeClass) const { return (classes[sizeClass].chunks.size() * NUM_PAGES()); }
+	size_t used_pages(size_t sizeClass) const { return classes[sizeClass].numUsed; }
+	size_t peak_pages(size_t sizeClass) const { return classes[sizeClass].peakUsed; }
+
+	bool mapped(const void* ptr) const {
+		const t_page_header* page = page_header_from_ptr(ptr);
+
+		if (page->sizeClass >= NUM_CLASSES())
+			return false;
+		if (page->index >= num_pages(page->sizeClass))
+			return false;
+
+		return (page_data(page_header(page->sizeClass, page->index)) == ptr);
+	}
+	bool alloced(const void* ptr) const { return (lastAlloc == ptr); }
+	bool can_alloc() const { return true; }
+	bool can_free() const { return (usedSize > 0); }
+
+private:
+	static_assert(sizeof...(Sizes) > 0, "");
+
+	static constexpr std::array<size_t, sizeof...(Sizes)> PAGE_SIZES = {Sizes...};
+
+	struct t_page_header {
+		uint32_t index;
+		uint32_t sizeClass;
+	};
+
+	struct alignas(Alignment) t_block {
+		uint8_t data[Alignment];
+	};
+
+	static constexpr size_t AlignedSize(size_t size) { return (((size + Alignment - 1) / Alignment) * Alignment); }
+	static constexpr size_t PAGE_HEADER_SIZE() { return (AlignedSize(sizeof(t_page_header))); }
+	static constexpr size_t PAGE_STRIDE(size_t sizeClass) { return (PAGE_HEADER_SIZE() + AlignedSize(PAGE_SIZE(sizeClass))); }
+
+	const t_page_header* page_header(size_t sizeClass, size_t idx) const {
+		const uint8_t* chunk = reinterpret_cast<const uint8_t*>(classes[sizeClass].chunks[idx / K].get());
+		return reinterpret_cast<const t_page_header*>(chunk + (idx % K) * PAGE_STRIDE(sizeClass));
+	}
+
+	t_page_header* page_header(size_t sizeClass, size_t idx) {
+		uint8_t* chunk = reinterpret_cast<uint8_t*>(classes[sizeClass].chunks[idx / K].get());
+		return reinterpret_cast<t_page_header*>(chunk + (idx % K) * PAGE_STRIDE(sizeClass));
+	}
+
+	static const void* page_data(const t_page_header* page) { return (reinterpret_cast<const uint8_t*>(page) + PAGE_HEADER_SIZE()); }
+	static void* page_data(t_page_header* page) { return (reinterpret_cast<uint8_t*>(page) + PAGE_HEADER_SIZE()); }
+
+	static const t_page_header* page_header_from_ptr(const void* ptr) {
+		return reinterpret_cast<const t_page_header*>(reinterpret_cast<const uint8_t*>(ptr) - PAGE_HEADER_SIZE());
+	}
+
+	struct t_size_class {
+		std::vector<std::unique_ptr<t_block[]>> chunks;
+		std::vector<uint32_t> indcs;
+
+		size_t numUsed = 0;
+		size_t peakUsed = 0;
+	};
+
+	std::array<t_size_class, sizeof...(Sizes)> classes;
+
+	size_t usedSize = 0;
+	size_t peakSize = 0;
+
+	const void* lastAlloc = nullptr;
+};
+
+
+// slab version
+// blocks of every size up to NumClasses * ClassStep are rounded up to the
+// next multiple of ClassStep and served from a per-class intrusive free-list
+// which is refilled by carving up a fresh SlabSize chunk; the caller has to
+// pass the size back to freeMem (there are no per-block headers) and clear
+// releases every slab at once, regardless of how many blocks are still live
+template<size_t NumClasses, size_t ClassStep, size_t SlabSize> struct SlabMemPool {
+public:
+	void* allocMem(size_t size) {
+		assert(size > 0 && size <= MAX_SIZE());
+
+		const size_t sizeClass = SIZE_CLASS(size);
+
+		t_size_class& sc = classes[sizeClass];
+
+		if (sc.freeList == nullptr)
+			refill(sizeClass);
+
+		t_free_block* block = sc.freeList;
+
+		sc.freeList = block->next;
+		sc.numUsed += 1;
+
+		usedSize += BLOCK_SIZE(sizeClass);
+		return block;
+	}
+
+	void freeMem(void* ptr, size_t size) {
+		assert(ptr != nullptr);
+		assert(size > 0 && size <= MAX_SIZE());
+
+		const size_t sizeClass = SIZE_CLASS(size);
+
+		t_size_class& sc = classes[sizeClass];
+		t_free_block* block = static_cast<t_free_block*>(ptr);
+
+		block->next = sc.freeList;
+
+		sc.freeList = block;
+		sc.numUsed -= 1;
+
+		usedSize -= BLOCK_SIZE(sizeClass);
+	}
+
+	void clear() {
+		slabs.clear();
+
+		for (t_size_class& sc: classes) {
+			sc.freeList = nullptr;
+			sc.numUsed = 0;
+			sc.numSlabs = 0;
+		}
+
+		usedSize = 0;
+	}
+
+	static constexpr size_t MAX_SIZE() { return (NumClasses * ClassStep); }
+	static constexpr size_t NUM_CLASSES() { return NumClasses; }
+	static constexpr size_t SIZE_CLASS(size_t size) { return ((size - 1) / ClassStep); }
+	static constexpr size_t BLOCK_SIZE(size_t sizeClass) { return ((sizeClass + 1) * ClassStep); }
+
+	size_t slab_size() const { return (slabs.size() * SlabSize); } // size of all slabs carved up since the last clear
+	size_t used_size() const { return usedSize; } // size of all live blocks, rounded up to their class
+	size_t free_size() const { return (slab_size() - usedSize); }
+
+	size_t num_slabs(size_t sizeClass) const { return classes[sizeClass].numSlabs; }
+	size_t used_blocks(size_t sizeClass) const { return classes[sizeClass].numUsed; }
+
+private:
+	static_assert(ClassStep >= sizeof(void*) && (ClassStep % alignof(void*)) == 0, "");
+	static_assert(SlabSize >= MAX_SIZE() && (SlabSize % sizeof(std::max_align_t)) == 0, "");
+
+	struct t_free_block {
+		t_free_block* next;
+	};
+
+	void refill(size_t sizeClass) {
+		slabs.emplace_back(new std::max_align_t[SlabSize / sizeof(std::max_align_t)]);
+
+		t_size_class& sc = classes[sizeClass];
+		uint8_t* slab = reinterpret_cast<uint8_t*>(slabs.back().get());
+
+		// link in reverse so blocks are handed out in address order
+		for (size_t n = SlabSize / BLOCK_SIZE(sizeClass); n > 0; n--) {
+			t_free_block* block = reinterpret_cast<t_free_block*>(slab + (n - 1) * BLOCK_SIZE(sizeClass));
+
+			block->next = sc.freeList;
+			sc.freeList = block;
+		}
+
+		sc.numSlabs += 1;
+	}
+
+	struct t_size_class {
+		t_free_block* freeList = nullptr;
+
+		size_t numUsed = 0;
+		size_t numSlabs = 0;
+	};
+
+	std::array<t_size_class, NumClasses> classes;
+	std::vector<std::unique_ptr<std::max_align_t[]>> slabs;
+
+	size_t usedSize = 0;
+};
+
+
 // dynamic memory allocator operating with stable index positions
 // has gaps management
 template <typename T>
@@ -40,6 +40,7 @@
 #include "Game/UI/ScanCodes.h"
 #include "Game/UI/InfoConsole.h"
 #include "Game/UI/MouseHandler.h"
+#include "Lua/LuaGarbageCollectCtrl.h"
 #include "Lua/LuaOpenGL.h"
 #include "Lua/LuaVFSDownload.h"
 #include "Menu/LuaMenuController.h"
@@ -224,6 +225,8 @@ bool SpringApp::Init()
 {
 	SpringMath::Init();
 	LuaMemPool::InitStatic(configHandler->GetBool("UseLuaMemPools"));
+	// also drives LuaMenu's collections, so can not wait for CGame
+	luaGCSched.Init(configHandler->GetBool("LuaGarbageCollectionScheduler"), configHandler->GetFloat("LuaGarbageCollectionSlackMult"));
 
 	CGlobalRendering::InitStatic();
 	globalRendering->SetFullScreen(FLAGS_window, FLAGS_fullscreen);
@@ -115,10 +115,8 @@ union creg_TKey {
 
 
 struct creg_Node {
-	CR_DECLARE_STRUCT(creg_Node)
 	creg_TValue i_val;
 	creg_TKey i_key;
-	void Serialize(creg::ISerializer* s);
 };
 
 ASSERT_SIZE(Node)
@@ -463,14 +461,6 @@ CR_REG_METADATA(creg_TValue, (
 ))
 
 
-CR_BIND_POOL(creg_Node, , allocProtector, freeProtector)
-CR_REG_METADATA(creg_Node, (
-	CR_MEMBER(i_val),
-	CR_IGNORED(i_key),
-	CR_SERIALIZER(Serialize)
-))
-
-
 CR_BIND_POOL(creg_Table, , luaContext.alloc, freeProtector)
 CR_REG_METADATA(creg_Table, (
 	CR_COMMON_HEADER(),
@@ -657,7 +647,7 @@ CR_REG_METADATA(creg_LG, (
 template<typename T, typename C>
 inline void SerializeCVector(creg::ISerializer* s, T** vecPtr, C count)
 {
-	std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
+	static const std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
 	T* vec;
 	if (!(s->IsWriting())) {
 		vec = (T*) luaContext.alloc(count * sizeof(T));
@@ -671,6 +661,27 @@ inline void SerializeCVector(creg::ISerializer* s, T** vecPtr, C count)
 	}
 }
 
+// Values that can never be the target of a pointer (everything but stack
+// slots and closed upvalues) are written inline rather than as embedded
+// creg objects, which saves an object id, an object table entry and the
+// per-object bookkeeping for each of them.
+inline void SerializeTValue(creg::ISerializer* s, creg_TValue* tv)
+{
+	s->SerializeInt(&tv->tt, sizeof(tv->tt));
+	tv->Serialize(s);
+}
+
+template<typename C>
+inline void SerializeTValueVector(creg::ISerializer* s, creg_TValue** vecPtr, C count)
+{
+	if (!s->IsWriting())
+		*vecPtr = (creg_TValue*) luaContext.alloc(count * sizeof(creg_TValue));
+
+	for (creg_TValue* tv = *vecPtr, *end = tv + count; tv != end; ++tv) {
+		SerializeTValue(s, tv);
+	}
+}
+
 template<typename T>
 void SerializePtr(creg::ISerializer* s, T** t) {
 	creg::ObjectPointerType<T> opt;
@@ -736,7 +747,7 @@ void creg_TValue::Serialize(creg::ISerializer* s)
 		case LUA_TSTRING: { SerializePtr(s, &value.gc); return; }
 		case LUA_TTABLE: { SerializePtr(s, &value.gc); return; }
 		case LUA_TFUNCTION: { SerializePtr(s, &value.gc); return; }
-		case LUA_TUSERDATA: { SerializePtr(s, &value.gc); }
+		case LUA_TUSERDATA: { SerializePtr(s, &value.gc); return; }
 		case LUA_TTHREAD: { SerializePtr(s, &value.gc); return; }
 		case LUA_TDEADKEY: { return; }
 		default: { assert(false); return; }
@@ -744,10 +755,28 @@ void creg_TValue::Serialize(creg::ISerializer* s)
 }
 
 
-void creg_Node::Serialize(creg::ISerializer* s)
+// collision chains never leave their node array, store them as indices
+static void SerializeNodeVector(creg::ISerializer* s, creg_Node** vecPtr, int count)
 {
-	SerializeInstance(s, &i_key.tvk);
-	SerializePtr(s, &i_key.nk.next);
+	if (!s->IsWriting())
+		*vecPtr = (creg_Node*) luaContext.alloc(count * sizeof(creg_Node));
+
+	creg_Node* vec = *vecPtr;
+
+	for (creg_Node* n = vec, *end = vec + count; n != end; ++n) {
+		// 0 marks the end of a chain
+		unsigned int nextIdx;
+
+		if (s->IsWriting())
+			nextIdx = (n->i_key.nk.next == nullptr)? 0: (n->i_key.nk.next - vec + 1);
+
+		SerializeTValue(s, &n->i_val);
+		SerializeTValue(s, &n->i_key.tvk);
+		s->SerializeInt(&nextIdx, sizeof(nextIdx));
+
+		if (!s->IsWriting())
+			n->i_key.nk.next = (nextIdx == 0)? nullptr: (vec + nextIdx - 1);
+	}
 }
 
 
@@ -755,7 +784,7 @@ void creg_Table::Serialize(creg::ISerializer* s)
 {
 	int sizenode = twoto(lsizenode);
 
-	SerializeCVector(s, &array, sizearray);
+	SerializeTValueVector(s, &array, sizearray);
 	bool empty;
 	creg_Node* dummy = GetDummyNode();
 	if (s->IsWriting())
@@ -770,7 +799,7 @@ void creg_Table::Serialize(creg::ISerializer* s)
 			assert(node == dummy);
 		}
 	} else {
-		SerializeCVector(s, &node, sizenode);
+		SerializeNodeVector(s, &node, sizenode);
 	}
 
 	ptrdiff_t lastfreeOffset;
@@ -817,7 +846,7 @@ void creg_Table::PostLoad()
 
 void creg_Proto::Serialize(creg::ISerializer* s)
 {
-	SerializeCVector(s, &k,        sizek);
+	SerializeTValueVector(s, &k,   sizek);
 	SerializeCVector(s, &code,     sizecode);
 	SerializeCVector(s, &p,        sizep);
 	SerializeCVector(s, &lineinfo, sizelineinfo);
@@ -868,7 +897,7 @@ void creg_CClosure::Serialize(creg::ISerializer* s)
 {
 	inClosure = true;
 	for (unsigned i = 0; i < nupvalues; ++i) {
-		SerializeInstance(s, &upvalue[i]);
+		SerializeTValue(s, &upvalue[i]);
 	}
 	inClosure = false;
 
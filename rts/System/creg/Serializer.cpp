@@ -82,12 +82,19 @@ static void WriteZStr(std::ostream& file, const std::string& str)
 template<typename T>
 void ReadVarSizeUInt(std::istream* stream, T* buf)
 {
+	// every object id and integer goes through here, bypass the per-call istream sentry
+	std::streambuf* sbuf = stream->rdbuf();
 	std::uint64_t val = 0;
 	unsigned offset = 0;
 	while (true) {
-		unsigned char a;
-		stream->read((char*)&a, sizeof(char));
+		const int c = sbuf->sbumpc();
 
+		if (c == std::streambuf::traits_type::eof()) {
+			stream->setstate(std::ios::eofbit | std::ios::failbit);
+			break;
+		}
+
+		const unsigned char a = c;
 		val += ((std::uint64_t)(a & 0x7F)) << offset;
 		if ((a & 0x80) == 0)
 			break;
@@ -101,6 +108,10 @@ void ReadVarSizeUInt(std::istream* stream, T* buf)
 template<typename T>
 void WriteVarSizeUInt(std::ostream* stream, T val)
 {
+	// at most ceil(64 / 7) bytes, written with a single call
+	unsigned char buf[10];
+	unsigned len = 0;
+
 	std::uint64_t v = val;
 	do {
 		unsigned char a = v & 0x7F;
@@ -109,8 +120,10 @@ void WriteVarSizeUInt(std::ostream* stream, T val)
 		if (v > 0)
 			a |= 0x80;
 
-		stream->write((char*)&a, sizeof(char));
+		buf[len++] = a;
 	} while (v > 0);
+
+	stream->write((char*)buf, len);
 }
 
 void creg::ReadUInt(std::istream* stream, std::uint64_t* buf)
@@ -148,49 +161,29 @@ COutputStreamSerializer::ObjectRef* COutputStreamSerializer::FindObjectRef(void*
 
 void COutputStreamSerializer::SerializeObject(Class* c, void* ptr, ObjectRef* objr)
 {
-	const unsigned objstart = stream->tellp();
+	// per-class sizes are only reported at debug level, skip the tellp calls otherwise
+	const bool collectSizes = LOG_IS_ENABLED(L_DEBUG);
+	const unsigned objstart = collectSizes? (unsigned) stream->tellp(): 0;
 
 	if (c->base())
 		SerializeObject(c->base(), ptr, objr);
 
-	ObjectMemberGroup omg;
-	omg.membersClass = c;
-	omg.size = 0;
-
 	for (uint a = 0; a < c->members.size(); a++)
 	{
 		creg::Class::Member* m = &c->members[a];
 		if (m->flags & CM_NoSerialize)
 			continue;
 
-		ObjectMember om;
-		om.member = m;
-		om.memberId = a;
 		void* memberAddr = ((char*)ptr) + m->offset;
-		unsigned mstart = stream->tellp();
 		LOG_SL(LOG_SECTION_CREG_SERIALIZER, L_DEBUG, "Serialized %s::%s type:%s", c->name, m->name, m->type->GetName().c_str());
 		m->type->Serialize(this, memberAddr);
-		unsigned mend = stream->tellp();
-		om.size = mend - mstart;
-		omg.members.push_back(om);
-		omg.size += om.size;
-		LOG_SL(LOG_SECTION_CREG_SERIALIZER, L_DEBUG, "Serialized %s::%s type:%s size:%d", c->name, m->name, m->type->GetName().c_str(), om.size);
 	}
 
-
-	if (c->HasSerialize()) {
-		ObjectMember om;
-		om.member = nullptr;
-		om.memberId = -1;
-		unsigned mstart = stream->tellp();
+	if (c->HasSerialize())
 		c->CallSerializeProc(ptr, this);
-		unsigned mend = stream->tellp();
-		om.size = mend - mstart;
-		omg.members.push_back(om);
-		omg.size += om.size;
-	}
 
-	objr->memberGroups.push_back(omg);
+	if (!collectSizes)
+		return;
 
 	const unsigned objend = stream->tellp();
 	const int sz = objend - objstart;
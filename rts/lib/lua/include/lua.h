@@ -266,6 +266,8 @@ LUA_API void lua_setallocf (lua_State *L, lua_Alloc f, void *ud);
 LUA_API lua_Hash (lua_calchash) (const char *s, size_t l);
 LUA_API void  (lua_pushhstring) (lua_State *L,
                                  lua_Hash h, const char *s, size_t l);
+LUA_API void  (lua_pushfixedhstring) (lua_State *L,
+                                      lua_Hash h, const char *s, size_t l);
 
 
 /* 
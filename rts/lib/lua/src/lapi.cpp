@@ -463,6 +463,20 @@ LUA_API void lua_pushhstring (lua_State *L,
 }
 
 
+//SPRING
+LUA_API void lua_pushfixedhstring (lua_State *L,
+                                   lua_Hash h, const char *s, size_t len) {
+  TString *ts;
+  lua_lock(L);
+  luaC_checkGC(L);
+  ts = luaS_newhstr(L, h, s, len);
+  luaS_fix(ts);  /* engine keys live as long as the state */
+  setsvalue2s(L, L->top, ts);
+  api_incr_top(L);
+  lua_unlock(L);
+}
+
+
 LUA_API void lua_pushstring (lua_State *L, const char *s) {
   if (s == NULL)
     lua_pushnil(L);
@@ -0,0 +1,77 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Lua/LuaCallInFilter.h"
+#include "lib/lua/include/LuaInclude.h"
+
+#define CATCH_CONFIG_MAIN
+#include "lib/catch.hpp"
+
+
+static constexpr size_t NUM_UNIT_DEFS = 8;
+static constexpr size_t NUM_TEAMS = 4;
+static constexpr size_t NUM_WEAPON_DEFS = 8;
+
+
+static LuaCallInFilter ParseFilter(const char* filterSrc)
+{
+	lua_State* L = luaL_newstate();
+	LuaCallInFilter filter;
+
+	REQUIRE(luaL_dostring(L, filterSrc) == 0);
+
+	filter.Parse(L, -1, NUM_UNIT_DEFS, NUM_TEAMS, NUM_WEAPON_DEFS);
+	CHECK(lua_gettop(L) == 1);
+
+	lua_close(L);
+	return filter;
+}
+
+
+TEST_CASE("LuaCallInFilter")
+{
+	SECTION("nil filter passes everything") {
+		const LuaCallInFilter filter = ParseFilter("return nil");
+
+		CHECK(filter.Pass(1, 0, 1));
+		CHECK(filter.Pass(NUM_UNIT_DEFS - 1, NUM_TEAMS - 1, NUM_WEAPON_DEFS - 1));
+	}
+
+	SECTION("empty arrays pass everything") {
+		const LuaCallInFilter filter = ParseFilter("return {unitDefs = {}, teams = {}, weaponDefs = {}}");
+
+		CHECK(filter.unitDefs.empty());
+		CHECK(filter.teams.empty());
+		CHECK(filter.weaponDefs.empty());
+
+		CHECK(filter.Pass(1, 0, 1));
+		CHECK(filter.Pass(NUM_UNIT_DEFS - 1, NUM_TEAMS - 1, NUM_WEAPON_DEFS - 1));
+	}
+
+	SECTION("empty table passes everything") {
+		const LuaCallInFilter filter = ParseFilter("return {}");
+
+		CHECK(filter.Pass(1, 0, 1));
+		CHECK(filter.Pass(NUM_UNIT_DEFS - 1, NUM_TEAMS - 1, NUM_WEAPON_DEFS - 1));
+	}
+
+	SECTION("given arrays restrict") {
+		const LuaCallInFilter filter = ParseFilter("return {unitDefs = {2, 3}, teams = {}, weaponDefs = {5}}");
+
+		CHECK( filter.Pass(2, 0, 5));
+		CHECK( filter.Pass(3, NUM_TEAMS - 1, 5));
+		CHECK(!filter.Pass(1, 0, 5));
+		CHECK(!filter.Pass(2, 0, 4));
+
+		// special weaponDefIDs and IDs outside of the masks
+		CHECK( filter.Pass(2, 0, -1));
+		CHECK(!filter.Pass(NUM_UNIT_DEFS, 0, 5));
+	}
+
+	SECTION("out-of-range and non-numeric IDs are ignored") {
+		const LuaCallInFilter filter = ParseFilter("return {teams = {-1, 'a', 1, 99}}");
+
+		CHECK( filter.Pass(0, 1, 0));
+		CHECK(!filter.Pass(0, 0, 0));
+		CHECK(!filter.Pass(0, NUM_TEAMS - 1, 0));
+	}
+}
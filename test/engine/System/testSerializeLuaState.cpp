@@ -98,4 +98,112 @@ TEST_CASE("SerializeLuaState")
 	CHECK(L_GC == flh.L_GC);
 
 	lua_close(flh.L);
-}
\ No newline at end of file
+}
+
+
+static void SaveAndReloadState(int idx)
+{
+	// gray lists are not saved, finish any pending GC cycle like CLuaStateCollector::Read
+	lua_gc(flh.L, LUA_GCCOLLECT, 0);
+
+	std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+	{
+		LuaRoot root;
+		creg::COutputStreamSerializer oser;
+		oser.SavePackage(&ss, &root, root.GetClass());
+	}
+
+	{
+		creg::CInputStreamSerializer iser;
+		void* loaded;
+		creg::Class* loadedCls;
+		creg::CopyLuaContext(flh.L);
+		LUA_CLOSE(&flh.L);
+		iser.LoadPackage(&ss, loaded, loadedCls);
+		LuaRoot* loadedRoot = (LuaRoot*) loaded;
+		delete loadedRoot;
+	}
+
+	lua_rawgeti(flh.L, LUA_REGISTRYINDEX, idx);
+	CHECK(lua_tothread(flh.L, -1) == flh.L_GC);
+	lua_pop(flh.L, 1);
+}
+
+static bool RunGlobalCheck(const char* name)
+{
+	lua_getglobal(flh.L, name);
+
+	if (lua_pcall(flh.L, 0, 1, 0) != 0) {
+		printf("%s\n", lua_tostring(flh.L, -1));
+		lua_pop(flh.L, 1);
+		return false;
+	}
+
+	const bool ret = lua_toboolean(flh.L, -1);
+	lua_pop(flh.L, 1);
+	return ret;
+}
+
+TEST_CASE("SerializeLuaStateRoundTrip")
+{
+	int context = 1;
+
+	flh.L = lua_newstate(l_alloc, &context);
+	lua_atpanic(flh.L, handlepanic);
+	SPRING_LUA_OPEN_LIB(flh.L, luaopen_base);
+	SPRING_LUA_OPEN_LIB(flh.L, luaopen_math);
+	SPRING_LUA_OPEN_LIB(flh.L, luaopen_table);
+	SPRING_LUA_OPEN_LIB(flh.L, luaopen_string);
+
+	lua_settop(flh.L, 0);
+	creg::AutoRegisterCFunctions("Test::", flh.L);
+	flh.L_GC = lua_newthread(flh.L);
+	int idx = luaL_ref(flh.L, LUA_REGISTRYINDEX);
+
+	// shared tables, repeated strings, table keys (which force a rehash
+	// on load), hash and array parts, upvalues and a suspended coroutine
+	const char* code =
+		"shared = {x = 1}\n"
+		"tableKey = {}\n"
+		"data = {a = shared, b = shared, list = {}, nested = {deep = {deeper = {\"leaf\"}}}, flag = true, name = \"repeated\", [tableKey] = \"tableKeyValue\"}\n"
+		"for i = 1, 1000 do data.list[i] = {id = i, name = \"repeated\", ref = shared, [i * 0.5] = -i} end\n"
+		"for i = 1, 100 do data[\"key\" .. i] = i * i end\n"
+		"local counter = 0\n"
+		"function inc() counter = counter + 1 return counter end\n"
+		"inc()\n"
+		"co = coroutine.create(function(a) while true do a = a + coroutine.yield(a) end end)\n"
+		"coroutine.resume(co, 10)\n"
+		"function verify()\n"
+		"  if data.a ~= shared or data.b ~= shared or shared.x ~= 1 then return false end\n"
+		"  if data.nested.deep.deeper[1] ~= \"leaf\" or data.flag ~= true then return false end\n"
+		"  if data[tableKey] ~= \"tableKeyValue\" then return false end\n"
+		"  if data.name ~= (\"rep\" .. \"eated\") then return false end\n"
+		"  if #data.list ~= 1000 then return false end\n"
+		"  for i = 1, 1000 do\n"
+		"    local e = data.list[i]\n"
+		"    if e.id ~= i or e.name ~= data.name or e.ref ~= shared or e[i * 0.5] ~= -i then return false end\n"
+		"  end\n"
+		"  for i = 1, 100 do if data[\"key\" .. i] ~= i * i then return false end end\n"
+		"  if inc() ~= 2 then return false end\n"
+		"  local ok, val = coroutine.resume(co, 5)\n"
+		"  if not ok or val ~= 15 then return false end\n"
+		"  return (string.format(\"%d\", 42) == \"42\" and math.max(1, 2) == 2)\n"
+		"end\n";
+
+	REQUIRE(luaL_loadbuffer(flh.L, code, strlen(code), "roundtrip") == 0);
+	REQUIRE(lua_pcall(flh.L, 0, 0, 0) == 0);
+
+	SaveAndReloadState(idx);
+	CHECK(RunGlobalCheck("verify"));
+
+	// a second round-trip must reproduce the (modified) state as well
+	const char* code2 = "shared.x = 2\nfunction verify2() return (data.a.x == 2 and data.b.x == 2 and inc() == 3) end\n";
+
+	REQUIRE(luaL_loadbuffer(flh.L, code2, strlen(code2), "roundtrip2") == 0);
+	REQUIRE(lua_pcall(flh.L, 0, 0, 0) == 0);
+
+	SaveAndReloadState(idx);
+	CHECK(RunGlobalCheck("verify2"));
+
+	lua_close(flh.L);
+}